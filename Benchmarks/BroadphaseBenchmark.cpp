@@ -0,0 +1,165 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+/*
+Compares the time taken by the RenderSystem to cull and batch its
+drawables, with and without broadphase culling, as the total number
+of drawables increases. The drawables are spread over a large area
+so that only a small number are visible at any time, and a few
+percent of them move each frame.
+*/
+
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/ecs/components/Drawable.hpp>
+#include <xyginext/ecs/systems/RenderSystem.hpp>
+
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include <array>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const float WorldSize = 40000.f;
+    const std::size_t WarmupFrames = 3;
+    const std::size_t FrameCount = 20;
+
+    struct Result final
+    {
+        float microseconds = 0.f;
+        std::size_t drawablesDrawn = 0;
+    };
+
+    Result runFrames(xy::Scene& scene, sf::RenderTexture& target, std::vector<xy::Entity>& entities,
+        std::mt19937& rng, bool broadphase)
+    {
+        auto& renderSystem = scene.getSystem<xy::RenderSystem>();
+        renderSystem.setBroadphaseCulling(broadphase);
+
+        for (auto i = 0u; i < WarmupFrames; ++i)
+        {
+            scene.update(0.f);
+            target.draw(renderSystem);
+        }
+
+        Result result;
+        sf::Int64 total = 0;
+        for (auto i = 0u; i < FrameCount; ++i)
+        {
+            for (auto j = 0u; j < entities.size() / 50; ++j)
+            {
+                entities[rng() % entities.size()].getComponent<xy::Transform>().move(3.f, 2.f);
+            }
+            scene.update(0.f);
+
+            //draws the same view twice, for example as a minimap
+            target.clear();
+            sf::Clock clock;
+            target.draw(renderSystem);
+            target.draw(renderSystem);
+            total += clock.getElapsedTime().asMicroseconds();
+            target.display();
+
+            result.drawablesDrawn = renderSystem.getStats().drawablesDrawn;
+        }
+        result.microseconds = static_cast<float>(total) / FrameCount;
+
+        return result;
+    }
+
+    void run(std::size_t count, sf::RenderTexture& target, const std::array<sf::Texture, 3u>& textures)
+    {
+        xy::MessageBus mb;
+        xy::Scene scene(mb, count + 1);
+        scene.addSystem<xy::RenderSystem>(mb);
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> position(-WorldSize / 2.f, WorldSize / 2.f);
+
+        std::vector<xy::Entity> entities;
+        entities.reserve(count);
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto entity = scene.createEntity();
+            entity.addComponent<xy::Transform>().setPosition(position(rng), position(rng));
+
+            auto& drawable = entity.addComponent<xy::Drawable>();
+            drawable.setTexture(&textures[i % textures.size()]);
+            drawable.setDepth(i % 5);
+
+            auto& verts = drawable.getVertices();
+            verts.emplace_back(sf::Vector2f(), sf::Vector2f());
+            verts.emplace_back(sf::Vector2f(32.f, 0.f), sf::Vector2f(32.f, 0.f));
+            verts.emplace_back(sf::Vector2f(32.f, 32.f), sf::Vector2f(32.f, 32.f));
+            verts.emplace_back(sf::Vector2f(0.f, 32.f), sf::Vector2f(0.f, 32.f));
+            drawable.updateLocalBounds();
+
+            entities.push_back(entity);
+        }
+
+        auto bruteForce = runFrames(scene, target, entities, rng, false);
+        auto broadphase = runFrames(scene, target, entities, rng, true);
+
+        std::printf("%8zu drawables: brute force %10.1f us, broadphase %10.1f us (%zu / %zu drawn)\n",
+            count, bruteForce.microseconds, broadphase.microseconds, broadphase.drawablesDrawn, bruteForce.drawablesDrawn);
+    }
+}
+
+int main()
+{
+    sf::RenderTexture target;
+    if (!target.create(1280, 720))
+    {
+        std::printf("Failed to create render target\n");
+        return 1;
+    }
+
+    std::array<sf::Texture, 3u> textures;
+    for (auto& texture : textures)
+    {
+        if (!texture.create(32, 32))
+        {
+            std::printf("Failed to create texture\n");
+            return 1;
+        }
+    }
+
+    std::printf("Average time to draw a 1280x720 view twice per frame, over %zu frames\n", FrameCount);
+    for (auto count : { 1000u, 10000u, 100000u })
+    {
+        run(count, target, textures);
+    }
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+/*
+Compares processing a Scene's systems in parallel, which is the default,
+with processing them serially. The Scene has four independent systems,
+each of which writes its own component and reads a shared one, followed
+by a system which reads all four so must wait for them. This is run with
+a light and a heavy amount of work per entity, to show both the overhead
+of scheduling and the speed up when there is enough work to share out.
+The number of worker threads may be given as the first argument, else
+the JobSystem default of one fewer than the number of hardware threads
+is used.
+*/
+
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/core/JobSystem.hpp>
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/System.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    const std::size_t EntityCount = 10000;
+    const std::size_t FrameCount = 200;
+
+    //number of iterations of busy work per entity per system
+    std::size_t workAmount = 1;
+
+    struct Shared final
+    {
+        float value = 1.f;
+    };
+
+    template <std::size_t ID>
+    struct Value final
+    {
+        float value = 0.f;
+    };
+
+    template <std::size_t ID>
+    class WorkSystem final : public xy::System
+    {
+    public:
+        explicit WorkSystem(xy::MessageBus& mb)
+            : xy::System(mb, typeid(WorkSystem<ID>))
+        {
+            requireComponent<Value<ID>>();
+            requireComponent<Shared>(xy::ComponentAccess::Read);
+            setConcurrent(true);
+        }
+
+        void process(float dt) override
+        {
+            each<Value<ID>, Shared>([dt](xy::Entity, Value<ID>& value, const Shared& shared)
+            {
+                for (auto i = 0u; i < workAmount; ++i)
+                {
+                    value.value = std::sin(value.value + (shared.value * dt));
+                }
+            });
+        }
+    };
+
+    class SumSystem final : public xy::System
+    {
+    public:
+        explicit SumSystem(xy::MessageBus& mb)
+            : xy::System(mb, typeid(SumSystem))
+        {
+            requireComponent<Value<0>>(xy::ComponentAccess::Read);
+            requireComponent<Value<1>>(xy::ComponentAccess::Read);
+            requireComponent<Value<2>>(xy::ComponentAccess::Read);
+            requireComponent<Value<3>>(xy::ComponentAccess::Read);
+            requireComponent<Shared>();
+            setConcurrent(true);
+        }
+
+        void process(float) override
+        {
+            each<Value<0>, Value<1>, Value<2>, Value<3>, Shared>(
+                [](xy::Entity, const Value<0>& a, const Value<1>& b, const Value<2>& c, const Value<3>& d, Shared& shared)
+            {
+                shared.value = 1.f + ((a.value + b.value + c.value + d.value) * 0.001f);
+            });
+        }
+    };
+
+    float run(xy::Scene& scene, bool parallel)
+    {
+        scene.setParallelProcessing(parallel);
+        scene.update(1.f / 60.f);
+
+        sf::Clock clock;
+        for (auto i = 0u; i < FrameCount; ++i)
+        {
+            scene.update(1.f / 60.f);
+        }
+        return static_cast<float>(clock.getElapsedTime().asMicroseconds()) / FrameCount / 1000.f;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1)
+    {
+        xy::JobSystem::setWorkerCount(std::strtoul(argv[1], nullptr, 10));
+    }
+
+    xy::MessageBus mb;
+    xy::Scene scene(mb, EntityCount + 1);
+    scene.addSystem<WorkSystem<0>>(mb);
+    scene.addSystem<WorkSystem<1>>(mb);
+    scene.addSystem<WorkSystem<2>>(mb);
+    scene.addSystem<WorkSystem<3>>(mb);
+    scene.addSystem<SumSystem>(mb);
+
+    for (auto i = 0u; i < EntityCount; ++i)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<Shared>();
+        entity.addComponent<Value<0>>();
+        entity.addComponent<Value<1>>();
+        entity.addComponent<Value<2>>();
+        entity.addComponent<Value<3>>();
+    }
+
+    std::printf("%zu entities, %zu worker threads, averaged over %zu frames\n", EntityCount, xy::JobSystem::getWorkerCount(), FrameCount);
+    for (auto work : { 1u, 50u })
+    {
+        workAmount = work;
+        const auto serial = run(scene, false);
+        const auto parallel = run(scene, true);
+        std::printf("%3zu iterations per entity: serial %.3f ms/frame, parallel %.3f ms/frame\n", workAmount, serial, parallel);
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+/*
+Measures the cost of updating 1000 score labels whose values change
+every frame, reporting the time taken by the TextSystem and the number
+of glyph and kerning lookups made per frame. Laying out every character
+of every label would need one glyph and one kerning lookup per character.
+The path to a font may be given as the first argument, else the font
+from the demo is used.
+*/
+
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/ecs/components/Drawable.hpp>
+#include <xyginext/ecs/components/Text.hpp>
+#include <xyginext/ecs/systems/TextSystem.hpp>
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const std::size_t LabelCount = 1000;
+    const std::size_t FrameCount = 300;
+}
+
+int main(int argc, char** argv)
+{
+    sf::Font font;
+    const std::string fontPath = (argc > 1) ? argv[1] : XY_BENCHMARK_FONT;
+    if (!font.loadFromFile(fontPath))
+    {
+        std::printf("Failed to load %s\n", fontPath.c_str());
+        return 1;
+    }
+
+    xy::MessageBus mb;
+    xy::Scene scene(mb, LabelCount + 1);
+    scene.addSystem<xy::TextSystem>(mb);
+
+    std::vector<xy::Entity> labels;
+    for (auto i = 0u; i < LabelCount; ++i)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<xy::Transform>().setPosition(static_cast<float>(i % 10) * 120.f, static_cast<float>(i / 10) * 20.f);
+        entity.addComponent<xy::Drawable>();
+        entity.addComponent<xy::Text>(font).setCharacterSize(16);
+        labels.push_back(entity);
+    }
+
+    //the first frame adds the entities to the system and loads the glyphs
+    scene.update(0.f);
+
+    const auto startStats = xy::Text::getLayoutStats();
+    std::size_t characterCount = 0;
+    sf::Int64 total = 0;
+
+    for (auto frame = 0u; frame < FrameCount; ++frame)
+    {
+        for (auto i = 0u; i < labels.size(); ++i)
+        {
+            const auto score = "Score: " + std::to_string(100000 + (i * 37) + (frame * 3));
+            labels[i].getComponent<xy::Text>().setString(score);
+            characterCount += score.size();
+        }
+
+        sf::Clock clock;
+        scene.update(0.f);
+        total += clock.getElapsedTime().asMicroseconds();
+    }
+
+    const auto endStats = xy::Text::getLayoutStats();
+
+    std::printf("%zu labels changing every frame, averaged over %zu frames\n", LabelCount, FrameCount);
+    std::printf("%.3f ms/frame\n", static_cast<float>(total) / FrameCount / 1000.f);
+    std::printf("%zu characters per frame\n", characterCount / FrameCount);
+    std::printf("%zu getGlyph() calls per frame\n", (endStats.glyphLookups - startStats.glyphLookups) / FrameCount);
+    std::printf("%zu getKerning() calls per frame\n", (endStats.kerningLookups - startStats.kerningLookups) / FrameCount);
+    std::printf("%zu cached layouts\n", endStats.cachedLayouts);
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+/*
+Measures the cost of resolving world transforms in a scene graph of
+20,000 Transforms, in which each Transform has up to four children, and
+the root is rotated every frame so that every world transform changes.
+Every world transform is read each frame, as the RenderSystem would.
+The times compared are:
+- multiplying each local transform by all of its parents, with no caching
+- the lazily cached Transform::getWorldTransform()
+- updating the world transforms with the TransformSystem before reading them
+*/
+
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/ecs/systems/TransformSystem.hpp>
+
+#include <SFML/System/Clock.hpp>
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    const std::size_t TransformCount = 20000;
+    const std::size_t ChildCount = 4;
+    const std::size_t FrameCount = 100;
+
+    //index of each transform's parent, or -1 for the root
+    std::vector<int> parents;
+
+    sf::Transform getRecursiveTransform(std::vector<xy::Entity>& entities, int index)
+    {
+        const auto& local = entities[index].getComponent<xy::Transform>().getTransform();
+        if (parents[index] < 0)
+        {
+            return local;
+        }
+        return getRecursiveTransform(entities, parents[index]) * local;
+    }
+
+    template <typename Fn>
+    float time(xy::Scene& scene, std::vector<xy::Entity>& entities, Fn&& readTransforms)
+    {
+        auto& root = entities[0].getComponent<xy::Transform>();
+
+        sf::Clock clock;
+        for (auto i = 0u; i < FrameCount; ++i)
+        {
+            root.rotate(1.f);
+            scene.update(0.f);
+            readTransforms();
+        }
+        return static_cast<float>(clock.getElapsedTime().asMicroseconds()) / FrameCount / 1000.f;
+    }
+}
+
+int main()
+{
+    xy::MessageBus mb;
+    xy::Scene scene(mb, TransformCount + 1);
+    scene.addSystem<xy::TransformSystem>(mb);
+
+    std::vector<xy::Entity> entities;
+    entities.reserve(TransformCount);
+    parents.resize(TransformCount, -1);
+
+    for (auto i = 0u; i < TransformCount; ++i)
+    {
+        auto entity = scene.createEntity();
+        auto& tx = entity.addComponent<xy::Transform>();
+        tx.setPosition(1.f, 2.f);
+        tx.setRotation(static_cast<float>(i));
+        entities.push_back(entity);
+    }
+
+    for (auto i = 1u; i < TransformCount; ++i)
+    {
+        parents[i] = static_cast<int>((i - 1) / ChildCount);
+        entities[parents[i]].getComponent<xy::Transform>().addChild(entities[i].getComponent<xy::Transform>());
+    }
+    scene.update(0.f);
+
+    //read the results so the work can't be optimised away
+    float checksum = 0.f;
+
+    scene.setSystemActive<xy::TransformSystem>(false);
+    const auto recursiveTime = time(scene, entities, [&]()
+    {
+        for (auto i = 0u; i < entities.size(); ++i)
+        {
+            checksum += getRecursiveTransform(entities, i).getMatrix()[12];
+        }
+    });
+
+    auto readWorldTransforms = [&]()
+    {
+        for (auto entity : entities)
+        {
+            checksum += entity.getComponent<xy::Transform>().getWorldTransform().getMatrix()[12];
+        }
+    };
+    const auto lazyTime = time(scene, entities, readWorldTransforms);
+
+    scene.setSystemActive<xy::TransformSystem>(true);
+    const auto systemTime = time(scene, entities, readWorldTransforms);
+
+    std::printf("%zu transforms, averaged over %zu frames\n", TransformCount, FrameCount);
+    std::printf("Recursive, uncached:   %.3f ms/frame\n", recursiveTime);
+    std::printf("getWorldTransform():   %.3f ms/frame\n", lazyTime);
+    std::printf("TransformSystem:       %.3f ms/frame\n", systemTime);
+    std::printf("(checksum %f)\n", checksum);
+
+    return 0;
+}
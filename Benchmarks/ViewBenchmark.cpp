@@ -0,0 +1,148 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+/*
+Compares the cost of iterating the components of a system's entities
+with Entity::getComponent(), with System::each() and with a Scene::view()
+over 100,000 entities, of which every other one belongs to the system.
+*/
+
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/System.hpp>
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cstdio>
+
+namespace
+{
+    const std::size_t EntityCount = 100000;
+    const std::size_t PassCount = 100;
+
+    struct Position final
+    {
+        sf::Vector2f value;
+    };
+
+    struct Velocity final
+    {
+        sf::Vector2f value;
+    };
+
+    class MovementSystem final : public xy::System
+    {
+    public:
+        explicit MovementSystem(xy::MessageBus& mb)
+            : xy::System(mb, typeid(MovementSystem))
+        {
+            requireComponent<Position>();
+            requireComponent<Velocity>();
+        }
+
+        bool useEach = true;
+
+        void process(float dt) override
+        {
+            if (useEach)
+            {
+                each<Position, Velocity>([dt](xy::Entity, Position& position, const Velocity& velocity)
+                {
+                    position.value += velocity.value * dt;
+                });
+            }
+            else
+            {
+                for (auto entity : getEntities())
+                {
+                    entity.getComponent<Position>().value += entity.getComponent<Velocity>().value * dt;
+                }
+            }
+        }
+    };
+
+    template <typename Fn>
+    float time(Fn&& fn)
+    {
+        sf::Clock clock;
+        for (auto i = 0u; i < PassCount; ++i)
+        {
+            fn();
+        }
+        return static_cast<float>(clock.getElapsedTime().asMicroseconds()) / PassCount / 1000.f;
+    }
+}
+
+int main()
+{
+    xy::MessageBus mb;
+    xy::Scene scene(mb, EntityCount + 1);
+    auto& system = scene.addSystem<MovementSystem>(mb);
+
+    for (auto i = 0u; i < EntityCount; ++i)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<Position>();
+        if (i % 2 == 0)
+        {
+            entity.addComponent<Velocity>().value = { 1.f, 2.f };
+        }
+    }
+    scene.update(0.f);
+
+    const float dt = 1.f / 60.f;
+    system.useEach = false;
+    const auto getComponentTime = time([&]() { system.process(dt); });
+
+    system.useEach = true;
+    const auto eachTime = time([&]() { system.process(dt); });
+
+    const auto viewTime = time([&]()
+    {
+        scene.view<Position, Velocity>().each([dt](xy::Entity, Position& position, const Velocity& velocity)
+        {
+            position.value += velocity.value * dt;
+        });
+    });
+
+    //read the results so the work can't be optimised away
+    float checksum = 0.f;
+    scene.view<Position>().each([&checksum](xy::Entity, const Position& position)
+    {
+        checksum += position.value.x;
+    });
+
+    std::printf("%zu entities, half of which have a Velocity, averaged over %zu passes\n", EntityCount, PassCount);
+    std::printf("Entity::getComponent(): %.3f ms\n", getComponentTime);
+    std::printf("System::each():         %.3f ms\n", eachTime);
+    std::printf("Scene::view():          %.3f ms\n", viewTime);
+    std::printf("(checksum %f)\n", checksum);
+
+    return 0;
+}
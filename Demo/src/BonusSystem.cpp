@@ -187,7 +187,7 @@ void BonusSystem::spawn(float x, float y)
     entity.getComponent<CollisionComponent>().setCollisionMaskBits(CollisionFlags::Solid | CollisionFlags::Player | CollisionFlags::Platform);
     entity.addComponent<xy::QuadTreeItem>().setArea(BubbleBounds);
 
-    entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem; //so we can destroy at whim
+    entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem); //so we can destroy at whim
     entity.addComponent<AnimationController>().nextAnimation = static_cast<AnimationController::Animation>(value);
 
 
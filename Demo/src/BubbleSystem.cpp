@@ -53,6 +53,8 @@ BubbleSystem::BubbleSystem(xy::MessageBus& mb, xy::NetHost& host)
     m_host      (host),
     m_enabled   (true)
 {
+    subscribe(MessageID::PlayerMessage);
+
     requireComponent<xy::Transform>();
     requireComponent<Actor>();
     requireComponent<Bubble>();
@@ -88,7 +90,7 @@ void BubbleSystem::handleMessage(const xy::Message& msg)
             entity.addComponent<xy::QuadTreeItem>().setArea(BubbleBounds);
 
             entity.addComponent<AnimationController>();
-            entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem; //so we can destroy at whim
+            entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem); //so we can destroy at whim
 
             //broadcast to clients
             ActorEvent evt;
@@ -63,6 +63,8 @@ CrateSystem::CrateSystem(xy::MessageBus& mb, xy::NetHost& nh)
     m_host          (nh),
     m_respawnCount  (0)
 {
+    subscribe(MessageID::MapMessage);
+
     requireComponent<Crate>();
     requireComponent<xy::Transform>();
 
@@ -388,7 +390,7 @@ void CrateSystem::destroy(xy::Entity entity)
         expEnt.getComponent<CollisionComponent>().setCollisionMaskBits(CollisionFlags::ExplosionMask);
         expEnt.addComponent<xy::QuadTreeItem>().setArea(ExplosionBounds);
         expEnt.addComponent<AnimationController>();
-        expEnt.addComponent<xy::CommandTarget>().ID = CommandID::MapItem;
+        expEnt.addComponent<xy::CommandTarget>().setID(CommandID::MapItem);
 
         //broadcast to clients
         evt.actor = expEnt.getComponent<Actor>();
@@ -416,7 +418,7 @@ void CrateSystem::destroy(xy::Entity entity)
             dynEnt.addComponent<Actor>().id = dynEnt.getIndex();
             dynEnt.getComponent<Actor>().type = ActorID::Dynamite;
             dynEnt.addComponent<AnimationController>();
-            dynEnt.addComponent<xy::CommandTarget>().ID = CommandID::MapItem;
+            dynEnt.addComponent<xy::CommandTarget>().setID(CommandID::MapItem);
             dynEnt.addComponent<Dynamite>().callback = spawnExplosion;
             dynEnt.getComponent<Dynamite>().velocity = { static_cast<float>(xy::Util::Random::value(-1, 1)) * 500.f, -300.f };
             dynEnt.getComponent<Dynamite>().lifetime += xy::Util::Random::value(0.1f, 0.5f);
@@ -453,7 +455,7 @@ void CrateSystem::spawn(Crate crate)
     entity.addComponent<xy::QuadTreeItem>().setArea(CrateBounds);
 
     entity.addComponent<AnimationController>();
-    entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem;
+    entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem);
 
     crate.velocity = {};
     crate.lastOwner = 3;
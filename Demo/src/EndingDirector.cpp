@@ -100,6 +100,9 @@ EndingDirector::EndingDirector(xy::AudioResource& ar, xy::TextureResource& tr, x
     m_textureResource   (tr),
     m_messageBus        (mb)
 {
+    subscribe(Messages::SpriteMessage);
+    subscribe(Messages::SpeechMessage);
+
     m_spriteSheet.loadFromFile("assets/sprites/ending_food.spt", m_textureResource);
 }
 
@@ -158,7 +161,7 @@ void EndingDirector::handleMessage(const xy::Message& msg)
 
             auto entity = getScene().createEntity();
             entity.addComponent<xy::Transform>().setPosition(xy::DefaultSceneSize / 2.f);
-            entity.addComponent<xy::CommandTarget>().ID = Command::Clearable;
+            entity.addComponent<xy::CommandTarget>().setID(Command::Clearable);
             playSound(SoundID::Shout, entity);
         }
             break;
@@ -198,7 +201,7 @@ void EndingDirector::spawnBubble(sf::Uint32 id)
     auto foodEnt = scene.createEntity();
     foodEnt.addComponent<xy::Drawable>().setDepth(2);
     foodEnt.addComponent<xy::Transform>().setPosition(FoodPosition);
-    foodEnt.addComponent<xy::CommandTarget>().ID = Command::Clearable;
+    foodEnt.addComponent<xy::CommandTarget>().setID(Command::Clearable);
     switch (id)
     {
     default:break;
@@ -221,7 +224,7 @@ void EndingDirector::spawnBubble(sf::Uint32 id)
     }
     bubbleEnt.getComponent<xy::AudioEmitter>().setVolume(80.f);
     bubbleEnt.getComponent<xy::AudioEmitter>().setMinDistance(1920.f);
-    bubbleEnt.addComponent<xy::CommandTarget>().ID = Command::Clearable;
+    bubbleEnt.addComponent<xy::CommandTarget>().setID(Command::Clearable);
 
     
     bubbleEnt.addComponent<xy::Transform>().setPosition(PrincessPosition);
@@ -250,7 +253,7 @@ void EndingDirector::spawnFood(sf::Uint32 id)
     entity.addComponent<xy::Transform>().setPosition(PlayerPosition);
     entity.getComponent<xy::Transform>().setScale(2.f, 2.f);
     entity.addComponent<xy::Drawable>().setDepth(2);
-    entity.addComponent<xy::CommandTarget>().ID = Command::Clearable;
+    entity.addComponent<xy::CommandTarget>().setID(Command::Clearable);
 
     switch (id)
     {
@@ -286,7 +289,7 @@ void EndingDirector::spawnFood(sf::Uint32 id)
             particleEnt.addComponent<xy::Transform>().setPosition(foodEnt.getComponent<xy::Transform>().getPosition() + sf::Vector2f(32.f, 32.f));
             particleEnt.addComponent<xy::ParticleEmitter>().settings.loadFromFile("assets/particles/score.xyp", m_textureResource);
             particleEnt.getComponent<xy::ParticleEmitter>().start();
-            particleEnt.addComponent<xy::CommandTarget>().ID = Command::Clearable;
+            particleEnt.addComponent<xy::CommandTarget>().setID(Command::Clearable);
             playSound(SoundID::Pop, particleEnt);
 
             auto* msg = m_messageBus.post<SpriteEvent>(Messages::SpriteMessage);
@@ -314,7 +317,7 @@ void EndingDirector::spawnPause()
 {
     auto& scene = getScene();
     auto entity = scene.createEntity();
-    entity.addComponent<xy::CommandTarget>().ID = Command::Clearable;
+    entity.addComponent<xy::CommandTarget>().setID(Command::Clearable);
     entity.addComponent<xy::Transform>().setPosition(PausePosition);
     entity.getComponent<xy::Transform>().setScale(4.f, 4.f);
     auto bounds = entity.addComponent<xy::Sprite>(m_textureResource.get("assets/images/speech.png")).getTextureBounds();
@@ -371,7 +374,7 @@ void EndingDirector::spawnPause()
 
                 auto soundEnt = getScene().createEntity();
                 soundEnt.addComponent<xy::Transform>().setPosition(xy::DefaultSceneSize / 2.f);
-                soundEnt.addComponent<xy::CommandTarget>().ID = Command::Clearable;
+                soundEnt.addComponent<xy::CommandTarget>().setID(Command::Clearable);
                 playSound(SoundID::Angry, soundEnt);
             };
             sendCommand(cmd);
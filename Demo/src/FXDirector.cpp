@@ -42,6 +42,11 @@ namespace
 FXDirector::FXDirector()
     : m_nextFreeEntity(0)
 {
+    subscribe(MessageID::PlayerMessage);
+    subscribe(MessageID::SceneMessage);
+    subscribe(MessageID::AnimationMessage);
+    subscribe(MessageID::MapMessage);
+
     //TODO set up mapping in xygine
     m_soundResource.get("assets/sound/collect.wav");
     m_soundResource.get("assets/sound/jump.wav");
@@ -46,6 +46,8 @@ FruitSystem::FruitSystem(xy::MessageBus& mb, xy::NetHost& host)
     : xy::System(mb, typeid(FruitSystem)),
     m_host(host)
 {
+    subscribe(MessageID::SceneMessage);
+
     requireComponent<CollisionComponent>();
     requireComponent<xy::Transform>();
     requireComponent<Fruit>();
@@ -86,7 +88,7 @@ void FruitSystem::handleMessage(const xy::Message& msg)
                 entity.addComponent<xy::QuadTreeItem>().setArea(SmallFoodBounds);
 
                 entity.addComponent<AnimationController>();
-                entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem; //so we can destroy at whim
+                entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem); //so we can destroy at whim
 
                 //broadcast to clients
                 ActorEvent evt;
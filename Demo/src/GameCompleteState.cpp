@@ -202,7 +202,7 @@ void GameCompleteState::loadScene()
     entity.getComponent<xy::Transform>().setPosition(1090.f, 560.f);
     entity.getComponent<xy::Transform>().setScale(4.f, 4.f);
     entity.addComponent<xy::ParticleEmitter>().settings.loadFromFile("assets/particles/heart.xyp", m_textureResource);
-    entity.addComponent<xy::CommandTarget>().ID = Command::Princess | Command::Clearable;
+    entity.addComponent<xy::CommandTarget>().setID(Command::Princess | Command::Clearable);
     entity.addComponent<xy::Callback>(); //used later by ending director
 
     auto princessEnt = entity;
@@ -236,7 +236,7 @@ void GameCompleteState::loadScene()
             msg->event = SpriteEvent::ReachedTop;
         }
     };
-    entity.addComponent<xy::CommandTarget>().ID = Command::Player | Command::Clearable;
+    entity.addComponent<xy::CommandTarget>().setID(Command::Player | Command::Clearable);
     entity.addComponent<sf::Vector2f>(-300.f, -200.f); //used for fall velocity
 
     entity = m_scene.createEntity();
@@ -264,7 +264,7 @@ void GameCompleteState::loadUI()
     entity.getComponent<xy::Text>().setCharacterSize(60);
     entity.getComponent<xy::Text>().setAlignment(xy::Text::Alignment::Centre);
     entity.addComponent<xy::Drawable>().setDepth(2);
-    entity.addComponent<xy::CommandTarget>().ID = Command::Clearable;
+    entity.addComponent<xy::CommandTarget>().setID(Command::Clearable);
 }
 
 void GameCompleteState::showSummary()
@@ -101,6 +101,9 @@ GameoverState::GameoverState(xy::StateStack& stack, xy::State::Context ctx, cons
 GameoverState::~GameoverState()
 {
     xy::App::setMouseCursorVisible(false);
+
+    //m_font is owned by this state rather than a FontResource
+    xy::Text::clearGlyphCache();
 }
 
 bool GameoverState::handleEvent(const sf::Event& evt)
@@ -547,7 +547,7 @@ void GameState::loadAssets()
         ent.getComponent<xy::Drawable>().setShader(&m_backgroundShader);
         ent.addComponent<xy::Callback>().function = ColourRotator(m_backgroundShader);
     }
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::SceneBackground;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::SceneBackground);
 
     //flowers
     float flowerPos = startX + xy::Util::Random::value(20.f, 36.f);
@@ -583,7 +583,7 @@ void GameState::loadAssets()
     ent.getComponent<xy::AudioEmitter>().setLooped(true);
     ent.getComponent<xy::AudioEmitter>().setVolume(0.25f);
     ent.getComponent<xy::AudioEmitter>().setChannel(1);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::SceneMusic;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::SceneMusic);
 
     ent.addComponent<xy::Callback>().function = MusicCallback();
     ent.getComponent<xy::Callback>().active = true;
@@ -662,7 +662,7 @@ bool GameState::loadScene(const MapData& data, sf::Vector2f position)
     entity.addComponent<xy::Transform>().setPosition(position);
     entity.addComponent<MapAnimator>();
     if (position.y < 0) entity.getComponent<MapAnimator>().state = MapAnimator::State::Active;
-    entity.addComponent<xy::CommandTarget>().ID = CommandID::MapBackground;
+    entity.addComponent<xy::CommandTarget>().setID(CommandID::MapBackground);
 
     m_currentMapTexture = (m_currentMapTexture + 1) % m_mapTextures.size();
     
@@ -705,7 +705,7 @@ void GameState::loadTower()
     ent.getComponent<xy::Transform>().addChild(princessEnt.addComponent<xy::Transform>());
     princessEnt.getComponent<xy::Transform>().setPosition(128.f, 12.f);
     princessEnt.addComponent<xy::SpriteAnimation>().play(0);
-    princessEnt.addComponent<xy::CommandTarget>().ID = CommandID::Princess;
+    princessEnt.addComponent<xy::CommandTarget>().setID(CommandID::Princess);
     princessEnt.addComponent<AnimationController>().animationMap[AnimationController::Shoot] = princessSpriteSheet.getAnimationIndex("angry", "player_two");
     princessEnt.getComponent<AnimationController>().nextAnimation = AnimationController::Idle;
     princessEnt.getComponent<AnimationController>().direction = -1.f;
@@ -724,7 +724,7 @@ void GameState::loadTower()
     ent.getComponent<xy::Transform>().addChild(princessEnt.addComponent<xy::Transform>());
     princessEnt.getComponent<xy::Transform>().setPosition(64.f, 12.f);
     princessEnt.addComponent<xy::SpriteAnimation>().play(0);
-    princessEnt.addComponent<xy::CommandTarget>().ID = CommandID::Princess;
+    princessEnt.addComponent<xy::CommandTarget>().setID(CommandID::Princess);
     princessEnt.addComponent<AnimationController>().animationMap[AnimationController::Shoot] = princessSpriteSheet.getAnimationIndex("angry", "player_one");
     princessEnt.getComponent<AnimationController>().nextAnimation = AnimationController::Idle;
     princessEnt.addComponent<Actor>().id = princessEnt.getIndex();
@@ -739,7 +739,7 @@ void GameState::loadUI()
     ent.addComponent<xy::Text>(m_fontResource.get("assets/fonts/VeraMono.ttf"));
     ent.getComponent<xy::Text>().setFillColour(sf::Color::Red);
     ent.addComponent<xy::Drawable>().setDepth(10);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::Timeout | CommandID::UIElement;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::Timeout | CommandID::UIElement);
 
     //title texts
     auto& font = m_fontResource.get("assets/fonts/Cave-Story.ttf");
@@ -750,7 +750,7 @@ void GameState::loadUI()
     ent.getComponent<xy::Text>().setString("PLAYER ONE");
     ent.getComponent<xy::Text>().setCharacterSize(60);
     ent.addComponent<xy::Drawable>().setDepth(10);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::UIElement;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::UIElement);
     
     ent = m_scene.createEntity();
     ent.addComponent<xy::Transform>().setPosition((MapBounds.width / 2.f), 10.f);
@@ -760,7 +760,7 @@ void GameState::loadUI()
     ent.getComponent<xy::Text>().setCharacterSize(60);
     ent.getComponent<xy::Text>().setAlignment(xy::Text::Alignment::Centre);
     ent.addComponent<xy::Drawable>().setDepth(10);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::UIElement;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::UIElement);
     
     ent = m_scene.createEntity();
     ent.addComponent<xy::Transform>().setPosition(MapBounds.width - 260.f, 10.f);
@@ -769,7 +769,7 @@ void GameState::loadUI()
     ent.getComponent<xy::Text>().setString("PLAYER TWO");
     ent.getComponent<xy::Text>().setCharacterSize(60);
     ent.addComponent<xy::Drawable>().setDepth(10);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::UIElement;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::UIElement);
     
     //score texts
     ent = m_scene.createEntity();
@@ -778,7 +778,7 @@ void GameState::loadUI()
     ent.getComponent<xy::Text>().setString("0");
     ent.getComponent<xy::Text>().setCharacterSize(60);
     ent.addComponent<xy::Drawable>().setDepth(10);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::ScoreOne | CommandID::UIElement;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::ScoreOne | CommandID::UIElement);
 
     ent = m_scene.createEntity();
     ent.addComponent<xy::Transform>().setPosition((MapBounds.width / 2.f), 46.f);
@@ -787,7 +787,7 @@ void GameState::loadUI()
     ent.getComponent<xy::Text>().setCharacterSize(60);
     ent.getComponent<xy::Text>().setAlignment(xy::Text::Alignment::Centre);
     ent.addComponent<xy::Drawable>().setDepth(10);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::HighScore | CommandID::UIElement;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::HighScore | CommandID::UIElement);
 
     ent = m_scene.createEntity();
     ent.addComponent<xy::Transform>().setPosition(MapBounds.width - 260.f, 46.f);
@@ -795,7 +795,7 @@ void GameState::loadUI()
     ent.getComponent<xy::Text>().setString("0");
     ent.getComponent<xy::Text>().setCharacterSize(60);
     ent.addComponent<xy::Drawable>().setDepth(10);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::ScoreTwo | CommandID::UIElement;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::ScoreTwo | CommandID::UIElement);
 
 
     //lives display
@@ -807,7 +807,7 @@ void GameState::loadUI()
     ent.addComponent<xy::Sprite>() = spriteSheet.getSprite("player_one_lives");
     ent.addComponent<xy::Drawable>().setDepth(6);
     ent.addComponent<xy::SpriteAnimation>().play(0);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::LivesOne;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::LivesOne);
 
     ent = m_scene.createEntity();
     ent.addComponent<xy::Transform>().setPosition(MapBounds.width - 10.f, MapBounds.height - 96.f);
@@ -815,7 +815,7 @@ void GameState::loadUI()
     ent.addComponent<xy::Sprite>() = spriteSheet.getSprite("player_two_lives");
     ent.addComponent<xy::Drawable>().setDepth(6);
     ent.addComponent<xy::SpriteAnimation>().play(0);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::LivesTwo;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::LivesTwo);
 
     //level counter
     ent = m_scene.createEntity();
@@ -824,7 +824,7 @@ void GameState::loadUI()
     ent.getComponent<xy::Text>().setCharacterSize(60);
     ent.getComponent<xy::Text>().setAlignment(xy::Text::Alignment::Centre);
     ent.addComponent<xy::Drawable>().setDepth(10);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::LevelCounter | CommandID::UIElement;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::LevelCounter | CommandID::UIElement);
 
     ent = m_scene.createEntity();
     ent.addComponent<xy::Transform>().setPosition((MapBounds.width / 2.f), MapBounds.height - 148.f);
@@ -833,7 +833,7 @@ void GameState::loadUI()
     ent.getComponent<xy::Text>().setAlignment(xy::Text::Alignment::Centre);
     ent.getComponent<xy::Text>().setFillColour(sf::Color::Red);
     ent.addComponent<xy::Drawable>().setDepth(10);
-    ent.addComponent<xy::CommandTarget>().ID = CommandID::UIElement;
+    ent.addComponent<xy::CommandTarget>().setID(CommandID::UIElement);
 
     //bonus display
     float startY = (xy::DefaultSceneSize.y / 2.f) - (2.5f * BubbleBounds.height);
@@ -848,7 +848,7 @@ void GameState::loadUI()
             ent.addComponent<xy::Drawable>().setDepth(6);
             ent.getComponent<xy::Sprite>().setColour(sf::Color::Transparent);
             ent.addComponent<xy::SpriteAnimation>().play(j);
-            ent.addComponent<xy::CommandTarget>().ID = CommandID::BonusBall;
+            ent.addComponent<xy::CommandTarget>().setID(CommandID::BonusBall);
             ent.addComponent<BonusUI>().value = Bonus::valueMap[j];
             ent.getComponent<BonusUI>().playerID = i;
             bonusPosition.y += BubbleBounds.height;
@@ -1367,7 +1367,7 @@ void GameState::spawnActor(const ActorEvent& actorEvent)
     auto entity = m_scene.createEntity();
     entity.addComponent<xy::Transform>().setPosition(actorEvent.x, actorEvent.y);
     entity.addComponent<Actor>() = actorEvent.actor;
-    entity.addComponent<xy::CommandTarget>().ID = CommandID::NetActor | CommandID::MapItem;
+    entity.addComponent<xy::CommandTarget>().setID(CommandID::NetActor | CommandID::MapItem);
     entity.addComponent<InterpolationComponent>(point);
     entity.addComponent<AnimationController>();
 
@@ -1492,12 +1492,12 @@ void GameState::spawnClient(const ClientData& data)
     {
         entity.addComponent<xy::Sprite>() = m_sprites[SpriteID::PlayerOne];
         entity.getComponent<xy::Transform>().setScale(-1.f, 1.f);
-        entity.addComponent<xy::CommandTarget>().ID = CommandID::PlayerOne;
+        entity.addComponent<xy::CommandTarget>().setID(CommandID::PlayerOne);
     }
     else
     {
         entity.addComponent<xy::Sprite>() = m_sprites[SpriteID::PlayerTwo];
-        entity.addComponent<xy::CommandTarget>().ID = CommandID::PlayerTwo;
+        entity.addComponent<xy::CommandTarget>().setID(CommandID::PlayerTwo);
 
         if (m_sharedData.playerCount == 2)
         {
@@ -1560,7 +1560,8 @@ void GameState::spawnClient(const ClientData& data)
     else
     {
         //add interp controller
-        entity.getComponent<xy::CommandTarget>().ID |= CommandID::NetActor;
+        auto& commandTarget = entity.getComponent<xy::CommandTarget>();
+        commandTarget.setID(commandTarget.getID() | CommandID::NetActor);
         entity.addComponent<InterpolationComponent>();
     }
 }
@@ -1695,7 +1696,7 @@ void GameState::spawnMapActors()
         auto entity = m_scene.createEntity();
         entity.addComponent<xy::Transform>().setOrigin(WhirlyBobOrigin);
         entity.addComponent<Actor>() = m_mapData.NPCs[i];
-        entity.addComponent<xy::CommandTarget>().ID = CommandID::NetActor | CommandID::MapItem;
+        entity.addComponent<xy::CommandTarget>().setID(CommandID::NetActor | CommandID::MapItem);
         entity.addComponent<InterpolationComponent>();      
 
         /*
@@ -1749,7 +1750,7 @@ void GameState::spawnMapActors()
         auto entity = m_scene.createEntity();
         entity.addComponent<xy::Transform>().setOrigin(CrateOrigin);
         entity.addComponent<Actor>() = m_mapData.crates[i];
-        entity.addComponent<xy::CommandTarget>().ID = CommandID::NetActor | CommandID::MapItem;
+        entity.addComponent<xy::CommandTarget>().setID(CommandID::NetActor | CommandID::MapItem);
         entity.addComponent<InterpolationComponent>();
         entity.addComponent<xy::Sprite>() = m_sprites[SpriteID::Crate];
         entity.addComponent<xy::Drawable>().setDepth(-1);
@@ -1835,7 +1836,7 @@ void GameState::spawnTowerDude(sf::Int16 actorType)
     towerEnt.addComponent<xy::SpriteAnimation>();
     towerEnt.addComponent<MapAnimator>().state = MapAnimator::State::Static;
     towerEnt.getComponent<MapAnimator>().speed = 50.f;
-    towerEnt.addComponent<xy::CommandTarget>().ID = CommandID::TowerDude;
+    towerEnt.addComponent<xy::CommandTarget>().setID(CommandID::TowerDude);
     towerEnt.addComponent<xy::Callback>().function = TowerGuyCallback(m_scene);
 }
 
@@ -1984,7 +1985,7 @@ void GameState::giveHat(sf::Uint8 player)
         hatEnt.addComponent<xy::Sprite>() = m_sprites[SpriteID::MagicHat];
         hatEnt.addComponent<xy::Drawable>().setDepth(1);
         hatEnt.addComponent<xy::SpriteAnimation>();
-        hatEnt.addComponent<xy::CommandTarget>().ID = CommandID::Hat | CommandID::MapItem;
+        hatEnt.addComponent<xy::CommandTarget>().setID(CommandID::Hat | CommandID::MapItem);
         hatEnt.addComponent<AnimationController>() = m_animationControllers[SpriteID::MagicHat];
         hatEnt.addComponent<xy::Callback>().active = true;
         hatEnt.getComponent<xy::Callback>().function = [entity](xy::Entity hat, float)
@@ -2061,7 +2062,7 @@ void GameState::luggageChange(sf::Uint32 data)
             crateEnt.addComponent<xy::Sprite>() = m_sprites[SpriteID::Crate];
             crateEnt.addComponent<xy::Drawable>().setDepth(-4);
             crateEnt.addComponent<xy::SpriteAnimation>().play(explosive ? 1 : 0);
-            crateEnt.addComponent<xy::CommandTarget>().ID = CommandID::Luggage | CommandID::MapItem;
+            crateEnt.addComponent<xy::CommandTarget>().setID(CommandID::Luggage | CommandID::MapItem);
             crateEnt.addComponent<Actor>().id = actorID;
             crateEnt.getComponent<Actor>().type = ActorID::Crate;
 
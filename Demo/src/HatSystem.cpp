@@ -58,6 +58,9 @@ HatSystem::HatSystem(xy::MessageBus& mb, xy::NetHost& host)
     m_hatActive     (false),
     m_nextHatTime   (xy::Util::Random::value(MinHatTime, MaxHatTime))
 {
+    subscribe(MessageID::PlayerMessage);
+    subscribe(MessageID::MapMessage);
+
     requireComponent<MagicHat>();
     requireComponent<xy::Transform>();
     requireComponent<CollisionComponent>();
@@ -92,7 +95,7 @@ void HatSystem::handleMessage(const xy::Message& msg)
             entity.addComponent<xy::QuadTreeItem>().setArea(PlayerBounds);
 
             entity.addComponent<AnimationController>();
-            entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem; //so we can destroy at whim
+            entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem); //so we can destroy at whim
 
             //broadcast to clients
             ActorEvent evt;
@@ -167,7 +170,7 @@ void HatSystem::process(float dt)
             entity.addComponent<xy::QuadTreeItem>().setArea(PlayerBounds);
 
             entity.addComponent<AnimationController>();
-            entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem; //so we can destroy at whim
+            entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem); //so we can destroy at whim
 
             //broadcast to clients
             ActorEvent evt;
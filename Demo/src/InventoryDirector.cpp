@@ -61,7 +61,11 @@ InventoryDirector::InventoryDirector(xy::NetHost& host)
     m_queuePos  (0),
     m_hatTime   (HatAwardTime)
 {
-
+    subscribe(MessageID::GameMessage);
+    subscribe(MessageID::NpcMessage);
+    subscribe(MessageID::ItemMessage);
+    subscribe(MessageID::PlayerMessage);
+    subscribe(MessageID::NetworkMessage);
 }
 
 //public
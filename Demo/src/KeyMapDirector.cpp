@@ -43,6 +43,8 @@ KeyMapDirector::KeyMapDirector(SharedStateData& ssd, xy::ConfigFile& cfg)
     : m_sharedData(ssd),
     m_config(cfg)
 {
+    subscribe(MessageID::MenuMessage);
+
     m_cfgName = xy::FileSystem::getConfigDirectory(dataDir);
     m_cfgName += "keybinds.cfg";
 }
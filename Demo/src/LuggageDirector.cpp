@@ -46,7 +46,9 @@ namespace
 
 LuggageDirector::LuggageDirector(xy::NetHost& host)
     : m_host(host)
-{}
+{
+    subscribe(MessageID::PlayerMessage);
+}
 
 //public
 void LuggageDirector::handleMessage(const xy::Message& msg)
@@ -73,7 +73,7 @@ void MapAnimatorSystem::process(float dt)
                 animator.state = MapAnimator::State::Static;
 
                 if (entity.hasComponent<xy::CommandTarget>() &&
-                    entity.getComponent<xy::CommandTarget>().ID == CommandID::TowerDude)
+                    entity.getComponent<xy::CommandTarget>().getID() == CommandID::TowerDude)
                 {
                     entity.getComponent<xy::SpriteAnimation>().pause();
                 }
@@ -89,7 +89,7 @@ void MapAnimatorSystem::process(float dt)
                     cmd.action = [&](xy::Entity entity, float)
                     {
                         auto& animator = entity.getComponent<MapAnimator>();
-                        animator.dest = (entity.getComponent<xy::CommandTarget>().ID & CommandID::PlayerOne) ? PlayerOneSpawn : PlayerTwoSpawn;
+                        animator.dest = (entity.getComponent<xy::CommandTarget>().getID() & CommandID::PlayerOne) ? PlayerOneSpawn : PlayerTwoSpawn;
                         animator.state = MapAnimator::State::Active;
                     };
                     getScene()->getSystem<xy::CommandSystem>().sendCommand(cmd);
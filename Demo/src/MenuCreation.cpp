@@ -460,7 +460,7 @@ void MenuState::createThirdMenu(xy::Transform& parentTx, sf::Uint32 selectedID,
     bounds.width -= 72.f;
     bounds.left -= 148.f;
     entity.getComponent<xy::Drawable>().setCroppingArea(bounds);
-    entity.addComponent<xy::CommandTarget>().ID = CommandID::MenuText;
+    entity.addComponent<xy::CommandTarget>().setID(CommandID::MenuText);
     auto& tx3 = entity.addComponent<xy::Transform>();
     tx3.setPosition(192.f, 146.f);
 
@@ -625,7 +625,7 @@ void MenuState::createKeybindInputs(xy::Entity towerEnt, sf::Uint8 player)
             break;
         }
         entity.addComponent<xy::Drawable>().setDepth(2);
-        entity.addComponent<xy::CommandTarget>().ID = CommandID::KeybindInput;
+        entity.addComponent<xy::CommandTarget>().setID(CommandID::KeybindInput);
         entity.addComponent<KeyMapInput>().player = player;
         entity.getComponent<KeyMapInput>().index = i;
     }
@@ -567,6 +567,14 @@ void MenuState::createHelp()
     entity.getComponent<xy::Transform>().setScale(-1.f, 1.f);
     entity.addComponent<xy::SpriteAnimation>().play(spriteSheet.getAnimationIndex("jump_up", "player_one"));
 
+    //animation sets are shared by all sprites from the sheet, so loop a copy
+    auto loopAnimation = [](xy::Sprite& sprite, std::size_t index)
+    {
+        auto animations = std::make_shared<xy::AnimationSet>(*sprite.getAnimationSet());
+        animations->getAnimation(index).looped = true;
+        sprite.setAnimationSet(animations);
+    };
+
     entity = m_helpScene.createEntity();
     entity.addComponent<xy::Sprite>() = spriteSheet.getSprite("player_one");
     entity.addComponent<xy::Drawable>().setDepth(2);
@@ -575,7 +583,7 @@ void MenuState::createHelp()
     entity.getComponent<xy::Transform>().setOrigin(32.f, 0.f);
     entity.getComponent<xy::Transform>().setScale(-1.f, 1.f);
     entity.addComponent<xy::SpriteAnimation>().play(spriteSheet.getAnimationIndex("shoot", "player_one"));
-    entity.getComponent<xy::Sprite>().getAnimations()[spriteSheet.getAnimationIndex("shoot", "player_one")].looped = true;
+    loopAnimation(entity.getComponent<xy::Sprite>(), spriteSheet.getAnimationIndex("shoot", "player_one"));
 
     entity = m_helpScene.createEntity();
     entity.addComponent<xy::Sprite>() = spriteSheet.getSprite("player_one");
@@ -621,7 +629,7 @@ void MenuState::createHelp()
     entity.getComponent<xy::Transform>().setPosition(positions[1]);
     entity.getComponent<xy::Transform>().setOrigin(32.f, 0.f);
     entity.addComponent<xy::SpriteAnimation>().play(spriteSheet.getAnimationIndex("shoot", "player_two"));
-    entity.getComponent<xy::Sprite>().getAnimations()[spriteSheet.getAnimationIndex("shoot", "player_two")].looped = true;
+    loopAnimation(entity.getComponent<xy::Sprite>(), spriteSheet.getAnimationIndex("shoot", "player_two"));
 
     entity = m_helpScene.createEntity();
     entity.addComponent<xy::Sprite>() = spriteSheet.getSprite("player_two");
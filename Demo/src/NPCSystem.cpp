@@ -68,6 +68,8 @@ NPCSystem::NPCSystem(xy::MessageBus& mb, xy::NetHost& host)
     m_host              (host),
     m_currentThinkTime  (0)
 {
+    subscribe(MessageID::NpcMessage);
+
     requireComponent<NPC>();
     requireComponent<Actor>();
     requireComponent<CollisionComponent>();
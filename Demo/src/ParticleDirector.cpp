@@ -46,6 +46,9 @@ namespace
 ParticleDirector::ParticleDirector(xy::TextureResource& tr)
     : m_nextFreeEmitter  (0)
 {
+    subscribe(MessageID::SceneMessage);
+    subscribe(MessageID::AnimationMessage);
+
     //load particle presets
     m_settings[SettingsID::BubblePop].loadFromFile("assets/particles/pop.xyp", tr);
     m_settings[SettingsID::Score].loadFromFile("assets/particles/score.xyp", tr);
@@ -69,6 +69,9 @@ PauseState::PauseState(xy::StateStack& stack, xy::State::Context ctx)
 PauseState::~PauseState()
 {
     xy::App::setMouseCursorVisible(false);
+
+    //m_font is owned by this state rather than a FontResource
+    xy::Text::clearGlyphCache();
 }
 
 bool PauseState::handleEvent(const sf::Event& evt)
@@ -429,7 +429,7 @@ void PowerupSystem::spawn(sf::Int32 actorID, sf::Uint8 player)
 
     entity.addComponent<AnimationController>().nextAnimation = AnimationController::Idle;
     entity.addComponent<xy::QuadTreeItem>().setArea(BubbleBounds);
-    entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem;
+    entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem);
 
     //broadcast to clients
     ActorEvent evt;
@@ -464,7 +464,7 @@ void PowerupSystem::spawnFlame(sf::Vector2f position, sf::Uint8 player, Powerup:
 
     entity.addComponent<AnimationController>().nextAnimation = AnimationController::Shoot;
     entity.addComponent<xy::QuadTreeItem>().setArea(BubbleBounds);
-    entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem;
+    entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem);
 
 
     //broadcast to clients
@@ -640,7 +640,7 @@ void GameServer::checkMapStatus(float dt)
         cmd.targetFlags = CommandID::PlayerOne | CommandID::PlayerTwo;
         cmd.action = [&](xy::Entity entity, float)
         {
-            if (entity.getComponent<xy::CommandTarget>().ID & CommandID::PlayerOne)
+            if (entity.getComponent<xy::CommandTarget>().getID() & CommandID::PlayerOne)
             {
                 entity.getComponent<xy::Transform>().setPosition(PlayerOneSpawn);
             }
@@ -898,7 +898,7 @@ void GameServer::loadMap()
             entity.addComponent<xy::Transform>().setPosition(rect.left, rect.top);
             entity.addComponent<CollisionComponent>().addHitbox({ 0.f, 0.f, rect.width, rect.height }, CollisionType::HardBounds);
             entity.addComponent<xy::QuadTreeItem>().setArea({ 0.f, 0.f, rect.width, rect.height });
-            entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem;
+            entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem);
             entity.getComponent<CollisionComponent>().setCollisionCategoryBits(CollisionFlags::HardBounds);
             entity.getComponent<CollisionComponent>().setCollisionMaskBits(CollisionFlags::Bubble | CollisionFlags::MagicHat);
         }
@@ -1063,7 +1063,7 @@ sf::Int32 GameServer::spawnPlayer(std::size_t player)
     entity.addComponent<Player>().playerNumber = static_cast<sf::Uint8>(player);
     entity.getComponent<Player>().spawnPosition = entity.getComponent<xy::Transform>().getPosition();
     if (player == 1) entity.getComponent<Player>().sync.direction = Player::Direction::Left;
-    entity.addComponent<xy::CommandTarget>().ID = (player == 0) ? CommandID::PlayerOne : CommandID::PlayerTwo;
+    entity.addComponent<xy::CommandTarget>().setID((player == 0) ? CommandID::PlayerOne : CommandID::PlayerTwo);
 
     //raise a message to say this happened
     auto* msg = m_messageBus.post<PlayerEvent>(MessageID::PlayerMessage);
@@ -1083,7 +1083,7 @@ xy::Entity GameServer::spawnNPC(sf::Int32 id, sf::Vector2f pos)
     entity.addComponent<xy::QuadTreeItem>().setArea(WhirlyBobBounds);
 
     entity.addComponent<AnimationController>();
-    entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem | CommandID::NPC;
+    entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem | CommandID::NPC);
 
     entity.addComponent<NPC>();
     sf::Uint32 collisionFlags = CollisionFlags::NPCMask;
@@ -1148,7 +1148,7 @@ void GameServer::spawnCrate(sf::Vector2f position, sf::Uint8 flags)
     entity.addComponent<xy::QuadTreeItem>().setArea(CrateBounds);
 
     entity.addComponent<AnimationController>();
-    entity.addComponent<xy::CommandTarget>().ID = CommandID::MapItem;
+    entity.addComponent<xy::CommandTarget>().setID(CommandID::MapItem);
 
     entity.addComponent<Crate>().explosive = (flags & Crate::Explosive);
     entity.getComponent<Crate>().respawn = (flags & Crate::Respawn);
@@ -38,7 +38,7 @@ source distribution.
 
 TowerDirector::TowerDirector()
 {
-
+    subscribe(MessageID::AnimationMessage);
 }
 
 //public
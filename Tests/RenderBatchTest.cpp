@@ -0,0 +1,175 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+/*
+Checks the number of draw calls the RenderSystem makes when batching.
+Returns non-zero if any of the checks fail. Batches are prepared
+without drawing them, so no OpenGL context or display is required.
+*/
+
+#include <xyginext/core/MessageBus.hpp>
+#include <xyginext/ecs/Scene.hpp>
+#include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/ecs/components/Drawable.hpp>
+#include <xyginext/ecs/systems/RenderSystem.hpp>
+
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <iostream>
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool result, const char* description)
+    {
+        std::cout << (result ? "PASS: " : "FAIL: ") << description << std::endl;
+        if (!result)
+        {
+            failures++;
+        }
+    }
+
+    xy::Entity addQuad(xy::Scene& scene, sf::Vector2f position, const sf::Texture* texture,
+        sf::PrimitiveType primitiveType = sf::Quads, sf::Int32 depth = 0)
+    {
+        auto entity = scene.createEntity();
+        entity.addComponent<xy::Transform>().setPosition(position);
+
+        auto& drawable = entity.addComponent<xy::Drawable>();
+        drawable.setTexture(texture);
+        drawable.setPrimitiveType(primitiveType);
+        drawable.setDepth(depth);
+
+        auto& verts = drawable.getVertices();
+        verts.emplace_back(sf::Vector2f(), sf::Vector2f());
+        verts.emplace_back(sf::Vector2f(10.f, 0.f), sf::Vector2f(16.f, 0.f));
+        verts.emplace_back(sf::Vector2f(10.f, 10.f), sf::Vector2f(16.f, 16.f));
+        verts.emplace_back(sf::Vector2f(0.f, 10.f), sf::Vector2f(0.f, 16.f));
+        drawable.updateLocalBounds();
+
+        return entity;
+    }
+
+    const xy::RenderStats& prepareScene(xy::Scene& scene, const sf::View& view)
+    {
+        scene.update(0.f);
+        return scene.getSystem<xy::RenderSystem>().prepareBatches(view);
+    }
+}
+
+int main()
+{
+    //textures are only compared by address when batching, so
+    //they don't need to be created (which requires OpenGL)
+    alignas(sf::Texture) unsigned char textureStorage[2][sizeof(sf::Texture)];
+    const auto* textureA = reinterpret_cast<const sf::Texture*>(textureStorage[0]);
+    const auto* textureB = reinterpret_cast<const sf::Texture*>(textureStorage[1]);
+
+    const sf::View view(sf::FloatRect(0.f, 0.f, 800.f, 600.f));
+
+    for (auto broadphase : { false, true })
+    {
+        std::cout << (broadphase ? "Broadphase culling enabled" : "Broadphase culling disabled") << std::endl;
+
+        //quads sharing a texture are drawn with a single call
+        {
+            xy::MessageBus mb;
+            xy::Scene scene(mb);
+            scene.addSystem<xy::RenderSystem>(mb).setBroadphaseCulling(broadphase);
+
+            for (auto i = 0; i < 5000; ++i)
+            {
+                addQuad(scene, { static_cast<float>(i % 790), static_cast<float>((i / 790) * 10) }, textureA);
+            }
+
+            const auto& stats = prepareScene(scene, view);
+            check(stats.drawCalls == 1, "5000 quads with the same texture make 1 draw call");
+            check(stats.drawablesDrawn == 5000, "5000 quads with the same texture are all drawn");
+            check(stats.batchedDrawables == 5000, "5000 quads with the same texture are all batched");
+            check(stats.vertexCount == 20000, "5000 quads submit 20000 vertices");
+        }
+
+        //a change of texture between consecutive drawables splits the batch
+        {
+            xy::MessageBus mb;
+            xy::Scene scene(mb);
+            scene.addSystem<xy::RenderSystem>(mb).setBroadphaseCulling(broadphase);
+
+            for (auto i = 0; i < 10; ++i)
+            {
+                addQuad(scene, { i * 20.f, 10.f }, (i % 2) ? textureB : textureA, sf::Quads, i);
+            }
+
+            const auto& stats = prepareScene(scene, view);
+            check(stats.drawCalls == 10, "10 quads with alternating textures make 10 draw calls");
+            check(stats.batchedDrawables == 0, "quads with alternating textures are not batched");
+        }
+
+        //fan primitives are always drawn individually
+        {
+            xy::MessageBus mb;
+            xy::Scene scene(mb);
+            scene.addSystem<xy::RenderSystem>(mb).setBroadphaseCulling(broadphase);
+
+            for (auto i = 0; i < 4; ++i)
+            {
+                addQuad(scene, { i * 20.f, 10.f }, textureA);
+            }
+            addQuad(scene, { 100.f, 10.f }, textureA, sf::TriangleFan, 1);
+            addQuad(scene, { 120.f, 10.f }, textureA, sf::TriangleFan, 1);
+
+            const auto& stats = prepareScene(scene, view);
+            check(stats.drawCalls == 3, "4 quads and 2 triangle fans make 3 draw calls");
+            check(stats.batchedDrawables == 4, "only the quads are batched");
+        }
+
+        //culled drawables are excluded from the batches
+        {
+            xy::MessageBus mb;
+            xy::Scene scene(mb);
+            scene.addSystem<xy::RenderSystem>(mb).setBroadphaseCulling(broadphase);
+
+            for (auto i = 0; i < 10; ++i)
+            {
+                addQuad(scene, { i * 20.f, 10.f }, textureA);
+                addQuad(scene, { 2000.f + (i * 20.f), 10.f }, textureA);
+            }
+
+            const auto& stats = prepareScene(scene, view);
+            check(stats.drawCalls == 1, "visible quads make 1 draw call");
+            check(stats.drawablesDrawn == 10, "only visible quads are drawn");
+            check(stats.drawablesCulled == 10, "quads outside the view are culled");
+            check(stats.vertexCount == 40, "culled quads submit no vertices");
+        }
+    }
+
+    std::cout << failures << " checks failed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -28,6 +28,7 @@ source distribution.
 #include "InterpolationSystem.hpp"
 
 #include <xyginext/ecs/components/Transform.hpp>
+#include <xyginext/core/JobSystem.hpp>
 #include <xyginext/util/Math.hpp>
 
 #include <xyginext/util/Vector.hpp>
@@ -35,6 +36,7 @@ source distribution.
 namespace
 {
     const float MaxDistSqr = 460.f * 460.f; //if we're bigger than this go straight to dest to hide flickering
+    const std::size_t EntitiesPerJob = 128;
 
     float linearInterpRotation(float a, float b, float t)
     {
@@ -53,46 +55,52 @@ InterpolationSystem::InterpolationSystem(xy::MessageBus& mb)
 //public
 void InterpolationSystem::process(float dt)
 {
+    //each entity only touches its own transform so they can be updated in parallel
     auto& entities = getEntities();
-    for (auto& entity : entities)
+    xy::JobSystem::parallelFor("InterpolationSystem", entities.size(), EntitiesPerJob,
+        [&](std::size_t begin, std::size_t end)
     {
-        auto& tx = entity.getComponent<xy::Transform>();
-        auto& interp = entity.getComponent<InterpolationComponent>();
-        
-        //jump if a very large difference
-        auto diff = (interp.m_targetPoint.position - interp.m_previousPoint.position);
-        if (xy::Util::Vector::lengthSquared(diff) > MaxDistSqr)
+        for (auto i = begin; i < end; ++i)
         {
-            if (interp.m_enabled)
+            auto entity = entities[i];
+            auto& tx = entity.getComponent<xy::Transform>();
+            auto& interp = entity.getComponent<InterpolationComponent>();
+        
+            //jump if a very large difference
+            auto diff = (interp.m_targetPoint.position - interp.m_previousPoint.position);
+            if (xy::Util::Vector::lengthSquared(diff) > MaxDistSqr)
             {
-                tx.setPosition(interp.m_targetPoint.position);
-                tx.setRotation(interp.m_targetPoint.rotation);
-
-                interp.applyNextTarget();
+                if (interp.m_enabled)
+                {
+                    tx.setPosition(interp.m_targetPoint.position);
+                    tx.setRotation(interp.m_targetPoint.rotation);
+
+                    interp.applyNextTarget();
+                }
+                continue;
             }
-            continue;
-        }
-
-        //previous position + diff * timePassed
-        if (interp.m_enabled)
-        {
-            float currTime = std::min(interp.m_elapsedTime.getElapsedTime().asSeconds() / interp.m_timeDifference, 1.f);
 
-            if (currTime < 1)
-            {
-                tx.setRotation(linearInterpRotation(interp.m_previousPoint.rotation, interp.m_targetPoint.rotation, currTime));
-                tx.setPosition(interp.m_previousPoint.position + (diff * currTime));
-            }
-            else
+            //previous position + diff * timePassed
+            if (interp.m_enabled)
             {
-                tx.setPosition(interp.m_targetPoint.position);
-                tx.setRotation(interp.m_targetPoint.rotation);
-
-                //shift interp target to next in buffer if available
-                interp.applyNextTarget();
+                float currTime = std::min(interp.m_elapsedTime.getElapsedTime().asSeconds() / interp.m_timeDifference, 1.f);
+
+                if (currTime < 1)
+                {
+                    tx.setRotation(linearInterpRotation(interp.m_previousPoint.rotation, interp.m_targetPoint.rotation, currTime));
+                    tx.setPosition(interp.m_previousPoint.position + (diff * currTime));
+                }
+                else
+                {
+                    tx.setPosition(interp.m_targetPoint.position);
+                    tx.setRotation(interp.m_targetPoint.rotation);
+
+                    //shift interp target to next in buffer if available
+                    interp.applyNextTarget();
+                }
             }
         }
-    }
+    });
 }
 
 //private
@@ -62,6 +62,9 @@ SFXDirector::SFXDirector(xy::AudioResource& ar)
     : m_audioResource   (ar),
     m_nextFreeEntity    (0)
 {
+    //subscribe to the messages which should play sounds, eg
+    //subscribe(MessageID::SomeMessage);
+
     //pre-load sounds
     for (const auto& str : paths)
     {
@@ -42,6 +42,7 @@ The older revision of xygine can be found <a href="https://github.com/fallahn/xy
 
 #include "xyginext/core/StateStack.hpp"
 #include "xyginext/core/MessageBus.hpp"
+#include "xyginext/core/MessageTrace.hpp"
 #include "xyginext/Config.hpp"
 #include "xyginext/audio/Mixer.hpp"
 
@@ -245,6 +246,25 @@ namespace xy
         */
         static bool isMouseCursorVisible();
 
+        /*!
+        \brief Starts recording all window events and despatched messages
+        to a trace file at the given path, which can be played back with a
+        MessagePlayer. Any active recording is stopped first.
+        \returns true if the trace file was successfully created
+        \see MessageRecorder
+        */
+        bool startRecording(const std::string& path);
+
+        /*!
+        \brief Stops any active recording started with startRecording()
+        */
+        void stopRecording();
+
+        /*!
+        \brief Returns true if a recording is currently active
+        */
+        bool isRecording() const { return m_messageRecorder.isOpen(); }
+
     protected:
         /*!
         \brief Function for despatching all window events
@@ -316,6 +336,7 @@ namespace xy
         std::string m_applicationName;
 
         MessageBus m_messageBus;
+        MessageRecorder m_messageRecorder;
 
         std::function<void(float)> update;
         std::function<void(const sf::Event&)> eventHandler;
@@ -0,0 +1,169 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/System/Time.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+namespace xy
+{
+    namespace Detail
+    {
+        class JobScheduler;
+    }
+
+    /*!
+    \brief Static interface to xygine's job system.
+    The job system maintains a pool of worker threads, each with
+    its own queue of jobs. Jobs scheduled from a worker are pushed
+    to that worker's queue and executed in LIFO order, while idle
+    workers steal the oldest jobs from the queues of busy ones.
+    Jobs scheduled from any other thread, such as the main thread,
+    are placed in a shared queue from which all workers steal.
+
+    Jobs are grouped by a Counter, which can be waited on. Threads
+    waiting on a Counter help execute pending jobs rather than
+    blocking, so it is safe to schedule and wait on jobs from within
+    another job. Every job is tagged with a string, which is passed
+    to the profile callback (if one is set) along with the time the
+    job took to execute.
+
+    By default the job system creates one worker for each hardware
+    thread, less one for the main thread. With a worker count of 0
+    all jobs are executed immediately on the thread which schedules
+    them.
+    */
+    class XY_EXPORT_API JobSystem final
+    {
+    public:
+        using Job = std::function<void()>;
+
+        /*!
+        \brief Function signature used by parallelFor().
+        The function is passed the begin and end indices of
+        the range it should process.
+        */
+        using RangeFunc = std::function<void(std::size_t, std::size_t)>;
+
+        /*!
+        \brief Callback invoked after each job completes with the job's
+        tag, the index of the thread which executed it and the time it
+        took to execute. This is called from worker threads so any
+        implementation must be thread safe.
+        */
+        using ProfileCallback = std::function<void(const char*, std::size_t, sf::Time)>;
+
+        /*!
+        \brief Tracks the number of outstanding jobs scheduled with it.
+        Counters must outlive the jobs scheduled with them, so make sure
+        to wait() on a counter before it goes out of scope.
+        */
+        class XY_EXPORT_API Counter final
+        {
+        public:
+            Counter() : m_count(0) {}
+            ~Counter() = default;
+
+            Counter(const Counter&) = delete;
+            Counter(Counter&&) = delete;
+            Counter& operator = (const Counter&) = delete;
+            Counter& operator = (Counter&&) = delete;
+
+            /*!
+            \brief Returns true if all the jobs scheduled with this
+            counter have completed
+            */
+            bool done() const { return m_count.load(std::memory_order_acquire) == 0; }
+
+        private:
+            std::atomic<std::size_t> m_count;
+            friend class Detail::JobScheduler;
+        };
+
+        /*!
+        \brief Sets the number of worker threads.
+        Any existing workers are stopped and new ones created. This must
+        not be called while there are jobs outstanding, or from within a
+        job. 0 disables the worker threads entirely so that jobs are executed
+        on the thread which schedules them.
+        */
+        static void setWorkerCount(std::size_t count);
+
+        /*!
+        \brief Returns the number of worker threads, not including the main thread
+        */
+        static std::size_t getWorkerCount();
+
+        /*!
+        \brief Returns the index of the calling thread. 0 is returned for
+        any thread which is not a worker, else the worker number starting at 1
+        */
+        static std::size_t getThreadIndex();
+
+        /*!
+        \brief Schedules a job for execution
+        \param tag String used to identify the job when profiling.
+        This must remain valid until the job has completed, so string
+        literals are preferable.
+        \param job The job to execute
+        \param counter Counter with which to track the job's completion
+        */
+        static void schedule(const char* tag, Job job, Counter& counter);
+
+        /*!
+        \brief Waits until all jobs scheduled with the given counter have
+        completed. The calling thread executes pending jobs while it waits.
+        */
+        static void wait(Counter& counter);
+
+        /*!
+        \brief Splits the range [0, count) into chunks of grainSize and
+        processes them in parallel, returning once the entire range has been
+        processed. The calling thread processes the first chunk itself.
+        \param tag String used to identify the jobs when profiling
+        \param count Number of items in the range
+        \param grainSize Number of items processed by each job. This should be
+        large enough that the work done by each job outweighs the cost of scheduling it.
+        \param func Function called for each chunk with the begin and end index of the chunk
+        */
+        static void parallelFor(const char* tag, std::size_t count, std::size_t grainSize, const RangeFunc& func);
+
+        /*!
+        \brief Sets a callback to be invoked each time a job completes.
+        Pass nullptr to remove any existing callback. This should not be
+        set while there are jobs outstanding.
+        */
+        static void setProfileCallback(const ProfileCallback& callback);
+    };
+}
@@ -46,6 +46,8 @@ namespace xy
     class XY_EXPORT_API Message final
     {
         friend class MessageBus;
+        friend class MessageRecorder;
+        friend class MessagePlayer;
     public:
         using ID = sf::Int32;
         enum Type
@@ -33,6 +33,9 @@ source distribution.
 #include "xyginext/core/Assert.hpp"
 #include "xyginext/core/Message.hpp"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <type_traits>
 
@@ -59,8 +62,20 @@ namespace xy
     class XY_EXPORT_API MessageBus final
     {
     public:
+        /*!
+        \brief Statistics gathered by the MessageBus, which can be used
+        to tune the size of the message storage. \see getStats()
+        */
+        struct XY_EXPORT_API Stats final
+        {
+            std::size_t highWaterMark = 0; //!< Most bytes posted in a single frame
+            std::size_t peakMessageCount = 0; //!< Most messages posted in a single frame
+            std::size_t blockCount = 0; //!< Number of storage blocks currently allocated
+            std::vector<std::size_t> messageCounts; //!< Number of messages posted for each message ID, indexed by ID
+        };
+
         MessageBus();
-        ~MessageBus() = default;
+        ~MessageBus();
         MessageBus(const MessageBus&) = delete;
         MessageBus(MessageBus&&) = delete;
         MessageBus& operator = (const MessageBus&) = delete;
@@ -82,31 +97,69 @@ namespace xy
         Custom message types should have a unique 32 bit integer ID which can be used
         to identify the message type when reading messages. Message data has a maximum
         size of 128 bytes.
+        Messages are stored in a chain of fixed size blocks, which grows as needed
+        and is reused each frame, so the bus never overflows.
+        This function is not thread safe and should only be called from the
+        thread which reads the bus - use postFromThread() from worker threads.
         \param id Unique ID for this message type
         \returns Pointer to an empty message of given type.
         */
         template <typename T>
         T* post(Message::ID id)
         {
-            if (!m_enabled) return static_cast<T*>((void*)m_pendingBuffer.data());
+            XY_ASSERT(sizeof(T) < 128, "message size exceeds 128 bytes"); //limit custom data to 128 bytes
+            if (!m_enabled.load(std::memory_order_relaxed)) return static_cast<T*>((void*)m_scratchBuffer.data());
 
-            auto dataSize = sizeof(T);
-
-            XY_ASSERT(dataSize < 128, "message size exceeds 128 bytes"); //limit custom data to 128 bytes
-            XY_ASSERT(m_pendingBuffer.size() - (m_inPointer - m_pendingBuffer.data()) > (dataSize + MessageSize), "buffer overflow " + std::to_string(m_pendingCount)); //make sure we have enough room in the buffer
-            XY_WARNING(m_pendingBuffer.size() - (m_inPointer - m_pendingBuffer.data()) < 128, "Messagebus buffer is heavily contended!");
+            //worst case size, including padding to align the data and the next message
+            const std::size_t maxSize = MessageSize + alignof(T) + sizeof(T) + alignof(Message);
+            if (static_cast<std::size_t>(m_inEnd - m_inPointer) < maxSize)
+            {
+                addPendingBlock(maxSize);
+            }
 
             Message* msg = new (m_inPointer)Message();
-            m_inPointer += MessageSize;
             msg->id = id;
-            msg->m_dataSize = dataSize;
-            msg->m_data = new (m_inPointer)T();
-            m_inPointer += dataSize;
+            msg->m_dataSize = sizeof(T);
+            msg->m_data = new (align(m_inPointer + MessageSize, alignof(T)))T();
 
+            auto* next = align(static_cast<char*>(msg->m_data) + sizeof(T), alignof(Message));
+            m_pendingBytes += (next - m_inPointer);
+            m_inPointer = next;
             m_pendingCount++;
+
+            if (id >= 0 && static_cast<std::size_t>(id) < m_stats.messageCounts.size())
+            {
+                m_stats.messageCounts[id]++;
+            }
+            else
+            {
+                countMessage(id);
+            }
+
             return static_cast<T*>(msg->m_data);
         }
 
+        /*!
+        \brief Places a copy of the given message data on the message bus.
+        This may be called from any thread, such as jobs running on the
+        JobSystem or a network thread, without blocking.
+        Each posting thread writes to its own storage, which is merged into
+        the message bus when the current frame's messages have all been read,
+        so the message is despatched along with the messages posted by the
+        main thread during the same frame.
+        Message types must be trivially copyable, and have the same size
+        limit as post()
+        \param id Unique ID for this message type
+        \param data Message data to copy to the message bus
+        */
+        template <typename T>
+        void postFromThread(Message::ID id, const T& data)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "message types must be trivially copyable");
+            XY_ASSERT(sizeof(T) < 128, "message size exceeds 128 bytes");
+            postFromThread(id, &data, sizeof(T), alignof(T));
+        }
+
         /*!
         \brief Returns true if there are no messages left on the message bus
         */
@@ -118,6 +171,18 @@ namespace xy
         */
         std::size_t pendingMessageCount() const;
 
+        /*!
+        \brief Returns the statistics gathered since the bus was created
+        or resetStats() was last called
+        */
+        const Stats& getStats() const { return m_stats; }
+
+        /*!
+        \brief Resets the high water mark, peak message count and
+        per ID message counts
+        */
+        void resetStats();
+
         /*!
         \brief Disables the message bus.
         Used internally by xygine
@@ -126,13 +191,49 @@ namespace xy
 
     private:
 
-        std::vector<char> m_currentBuffer;
-        std::vector<char> m_pendingBuffer;
+        struct ProducerBlock;
+        struct Producer;
+
+        struct Block final
+        {
+            std::unique_ptr<char[]> data;
+            std::size_t size = 0;
+            std::size_t used = 0;
+        };
+
+        std::vector<Block> m_currentBlocks;
+        std::vector<Block> m_pendingBlocks;
+        std::vector<Block> m_freeBlocks;
+        std::vector<char> m_scratchBuffer; //returned by post() when disabled
+
         char* m_inPointer;
+        char* m_inEnd;
         char* m_outPointer;
+        std::size_t m_outBlock;
         std::size_t m_currentCount;
         std::size_t m_pendingCount;
+        std::size_t m_pendingBytes;
+
+        Stats m_stats;
+        std::atomic<bool> m_enabled;
+
+        //each thread which calls postFromThread() has its own producer
+        std::atomic<Producer*> m_producers;
+        const std::uint64_t m_uid;
+
+        void addPendingBlock(std::size_t minSize);
+        Block getFreeBlock(std::size_t minSize);
+        void countMessage(Message::ID);
 
-        bool m_enabled;
+        void postFromThread(Message::ID, const void* data, std::size_t size, std::size_t alignment);
+        Producer& getProducer();
+        void mergeProducers();
+        void mergeMessage(const Message&);
+
+        static char* align(char* ptr, std::size_t alignment)
+        {
+            const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+            return ptr + ((alignment - (address % alignment)) % alignment);
+        }
     };
 }
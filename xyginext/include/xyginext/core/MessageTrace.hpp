@@ -0,0 +1,188 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+#include "xyginext/core/Message.hpp"
+
+#include <SFML/Window/Event.hpp>
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace xy
+{
+    class MessageBus;
+    class Scene;
+
+    /*!
+    \brief Records despatched messages and window events to a binary trace file.
+    Each frame of the trace contains the frame number, the frame time, every
+    sf::Event forwarded by the App and the ID, size and raw data of every
+    message despatched from the MessageBus. The App owns a recorder which
+    can be controlled with App::startRecording() and App::stopRecording(),
+    or the record_start and record_stop console commands.
+    Traces are written in the native byte order and struct layout, so are
+    only guaranteed to play back on builds for the same platform.
+    \see MessagePlayer
+    */
+    class XY_EXPORT_API MessageRecorder final
+    {
+    public:
+        MessageRecorder();
+        ~MessageRecorder();
+        MessageRecorder(const MessageRecorder&) = delete;
+        MessageRecorder& operator = (const MessageRecorder&) = delete;
+
+        /*!
+        \brief Creates a new trace file at the given path, overwriting any
+        existing file.
+        \returns true on success else false
+        */
+        bool open(const std::string& path);
+
+        /*!
+        \brief Writes any recorded data for the current frame and closes
+        the trace file
+        */
+        void close();
+
+        /*!
+        \brief Returns true if a trace file is currently being written
+        */
+        bool isOpen() const { return m_file.is_open(); }
+
+        /*!
+        \brief Records an event for the current frame
+        */
+        void recordEvent(const sf::Event&);
+
+        /*!
+        \brief Records a message for the current frame.
+        Message data should contain only trivial data, as required
+        by the MessageBus, as it is written as raw bytes
+        */
+        void recordMessage(const Message&);
+
+        /*!
+        \brief Writes the current frame to the trace file
+        \param dt The frame time passed to the update of this frame
+        */
+        void endFrame(float dt);
+
+        /*!
+        \brief Returns the number of frames written to the current trace
+        */
+        sf::Uint32 getFrameCount() const { return m_frameCount; }
+
+    private:
+        std::ofstream m_file;
+        std::vector<char> m_eventData;
+        std::vector<char> m_messageData;
+        sf::Uint32 m_eventCount;
+        sf::Uint32 m_messageCount;
+        sf::Uint32 m_frameCount;
+    };
+
+    /*!
+    \brief Plays back a trace created by the MessageRecorder.
+    The entire trace is loaded into memory so that it can be played
+    back at full speed, for example to feed a headless Scene when
+    benchmarking or bisecting frame time regressions.
+    */
+    class XY_EXPORT_API MessagePlayer final
+    {
+    public:
+        MessagePlayer();
+
+        /*!
+        \brief Loads the trace file at the given path
+        \returns true on success, else false if the file could not be
+        read or is not a valid trace
+        */
+        bool loadFromFile(const std::string& path);
+
+        /*!
+        \brief Reads the next frame from the trace.
+        \returns false once the end of the trace is reached
+        */
+        bool nextFrame();
+
+        /*!
+        \brief Returns to the beginning of the trace
+        */
+        void rewind();
+
+        /*!
+        \brief Returns the recorded number of the frame last read with nextFrame()
+        */
+        sf::Uint32 getFrameNumber() const { return m_frameNumber; }
+
+        /*!
+        \brief Returns the frame time recorded for the current frame
+        */
+        float getFrameTime() const { return m_frameTime; }
+
+        /*!
+        \brief Returns the events recorded in the current frame
+        */
+        const std::vector<sf::Event>& getEvents() const { return m_events; }
+
+        /*!
+        \brief Returns the messages recorded in the current frame.
+        These are valid until the next call to nextFrame() or rewind()
+        */
+        const std::vector<Message>& getMessages() const { return m_messages; }
+
+        /*!
+        \brief Reads the next frame and forwards its events and messages
+        to the given Scene, before updating the Scene with the recorded frame time.
+        The trace already contains any messages raised by the Scene itself when
+        it was recorded, so the given MessageBus (which should be the one used by
+        the Scene) is emptied and its messages discarded.
+        \returns false once the end of the trace is reached
+        */
+        bool playFrame(Scene& scene, MessageBus& messageBus);
+
+    private:
+        std::vector<char> m_trace;
+        std::size_t m_readPosition;
+
+        sf::Uint32 m_frameNumber;
+        float m_frameTime;
+        std::vector<sf::Event> m_events;
+        std::vector<Message> m_messages;
+        std::vector<std::max_align_t> m_messageData;
+
+        template <typename T>
+        bool read(T&);
+    };
+}
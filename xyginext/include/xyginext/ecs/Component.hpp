@@ -35,9 +35,34 @@ source distribution.
 #include <vector>
 #include <typeindex>
 #include <algorithm>
+#include <limits>
 
 namespace xy
 {
+    namespace Detail
+    {
+        /*!
+        \brief Returns a process wide, unique index for the given type.
+        The registry lives inside the library so that indices remain
+        consistent across shared library boundaries.
+        */
+        XY_EXPORT_API std::size_t getComponentFamily(std::type_index);
+
+        /*!
+        \brief Caches the family index of a component type so that
+        it is looked up only once per type.
+        */
+        template <typename T>
+        struct ComponentFamily final
+        {
+            static std::size_t id()
+            {
+                static const std::size_t family = getComponentFamily(std::type_index(typeid(T)));
+                return family;
+            }
+        };
+    }
+
     class XY_EXPORT_API ComponentManager final
     {
     public:
@@ -50,14 +75,22 @@ namespace xy
         template <typename T>
         ID getID()
         {
-            auto id = std::type_index(typeid(T));
-            return getFromTypeID(id);
+            const auto family = Detail::ComponentFamily<T>::id();
+            if (family < m_IDs.size() && m_IDs[family] != InvalidID)
+            {
+                return m_IDs[family];
+            }
+            return assignID(family);
         }
 
         ID getFromTypeID(std::type_index);
 
     private:
+        static constexpr ID InvalidID = std::numeric_limits<ID>::max();
+
+        std::vector<ID> m_IDs; //< indexed by component family
+        ID m_nextID = 0;
 
-        std::vector<std::type_index> m_IDs;     
+        ID assignID(std::size_t);
     };
 }
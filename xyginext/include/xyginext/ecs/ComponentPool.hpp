@@ -30,6 +30,10 @@ source distribution.
 #include "xyginext/core/Assert.hpp"
 
 #include <vector>
+#include <memory>
+#include <limits>
+#include <new>
+#include <type_traits>
 
 namespace xy
 {
@@ -40,34 +44,185 @@ namespace xy
 		public:
 			virtual ~Pool() = default;
 			virtual void clear() = 0;
+			virtual bool contains(std::size_t) const = 0;
+			virtual void remove(std::size_t) = 0;
 		};
 
 		/*!
-		\brief memory pooling for components
+		\brief Approximate size in bytes of each page of component storage
+		*/
+		static constexpr std::size_t ComponentPageSize = 16384;
+
+		/*!
+		\brief memory pooling for components.
+		Components are stored in a sparse set: a sparse array indexed by entity
+		index maps to a densely packed array of components, alongside a parallel
+		array of the entity indices which own them. Memory usage therefore scales
+		with the number of components which actually exist rather than the range
+		of entity IDs, and the dense array can be iterated linearly.
+		The dense array is allocated in fixed size pages so that growing the pool
+		never relocates existing components. Removing a component moves the last
+		component in the pool into the vacated slot.
 		*/
 		template <class T>
 		class ComponentPool final : public Pool
 		{
 		public:
-			explicit ComponentPool(std::size_t size = 256) : m_pool(size) { }
+			static constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+			static constexpr std::size_t ComponentsPerPage = (sizeof(T) < ComponentPageSize) ? ComponentPageSize / sizeof(T) : 1;
+
+			/*!
+			\brief Constructor.
+			\param size Initial number of components to reserve book-keeping
+			space for. No component memory is allocated until components are
+			inserted.
+			*/
+			explicit ComponentPool(std::size_t size = 256)
+				: m_size(0)
+			{
+				m_entities.reserve(size);
+				m_pages.reserve((size / ComponentsPerPage) + 1);
+			}
+
+			~ComponentPool() { clear(); }
+
+			ComponentPool(const ComponentPool&) = delete;
+			ComponentPool(ComponentPool&&) = delete;
+			ComponentPool& operator = (const ComponentPool&) = delete;
+			ComponentPool& operator = (ComponentPool&&) = delete;
+
+			bool empty() const { return m_size == 0; }
+
+			/*!
+			\brief Returns the number of components currently in the pool
+			*/
+			std::size_t size() const { return m_size; }
+
+			/*!
+			\brief Returns the number of components which can be stored before
+			a new page is allocated
+			*/
+			std::size_t capacity() const { return m_pages.size() * ComponentsPerPage; }
+
+			void clear() override
+			{
+				for (auto i = 0u; i < m_size; ++i)
+				{
+					getDense(i).~T();
+				}
+				m_size = 0;
+				m_sparse.clear();
+				m_entities.clear();
+				m_pages.clear();
+			}
+
+			/*!
+			\brief Returns true if the entity at the given index has a component in this pool
+			*/
+			bool contains(std::size_t entityIndex) const override
+			{
+				return entityIndex < m_sparse.size() && m_sparse[entityIndex] != InvalidIndex;
+			}
+
+			/*!
+			\brief Inserts the given component for the entity at the given index,
+			replacing any existing component for that entity.
+			\returns Reference to the inserted component
+			*/
+			T& insert(std::size_t entityIndex, T&& component)
+			{
+				if (contains(entityIndex))
+				{
+					auto& c = getDense(m_sparse[entityIndex]);
+					c = std::move(component);
+					return c;
+				}
 
-			bool empty() const { return m_pool.empty(); }
-			std::size_t size() const { return m_pool.size(); }
-			void resize(std::size_t size)
-            {
-                m_pool.resize(size); 
-                LOG("Warning component pool " + std::string(typeid(T).name()) + " has been resized to " + std::to_string(m_pool.size()) + " - existing component references may be invalidated", xy::Logger::Type::Warning);
-            }
-			void clear() { m_pool.clear(); }
+				if (entityIndex >= m_sparse.size())
+				{
+					m_sparse.resize(entityIndex + 1, InvalidIndex);
+				}
 
-            T& at(std::size_t idx) { return m_pool.at(idx); }
-            const T& at(std::size_t idx) const { return m_pool.at(idx); }
+				if (m_size == capacity())
+				{
+					m_pages.emplace_back(std::make_unique<Page>());
+				}
 
-            T& operator [] (std::size_t index) { XY_ASSERT(index < m_pool.size(), "Index out of range"); return m_pool[index]; }
-			const T& operator [] (std::size_t index) const { XY_ASSERT(index < m_pool.size(), "Index out of range"); return m_pool[index]; }
+				auto* c = new (getSlot(m_size)) T(std::move(component));
+				m_sparse[entityIndex] = m_size;
+				m_entities.push_back(entityIndex);
+				m_size++;
+
+				return *c;
+			}
+
+			/*!
+			\brief Removes the component belonging to the entity at the given index, if it exists.
+			The last component in the dense array is moved into the vacated slot.
+			*/
+			void remove(std::size_t entityIndex) override
+			{
+				if (!contains(entityIndex))
+				{
+					return;
+				}
+
+				const auto denseIndex = m_sparse[entityIndex];
+				const auto lastIndex = m_size - 1;
+
+				if (denseIndex != lastIndex)
+				{
+					//move the removed component out first so its destructor
+					//runs on the correct data (eg transforms detach from their parent)
+					{
+						T removed(std::move(getDense(denseIndex)));
+					}
+					getDense(denseIndex) = std::move(getDense(lastIndex));
+					m_entities[denseIndex] = m_entities[lastIndex];
+					m_sparse[m_entities[denseIndex]] = denseIndex;
+				}
+
+				getDense(lastIndex).~T();
+				m_size--;
+				m_entities.pop_back();
+				m_sparse[entityIndex] = InvalidIndex;
+			}
+
+			/*!
+			\brief Returns the component belonging to the entity at the given index
+			*/
+			T& operator [] (std::size_t entityIndex) { XY_ASSERT(contains(entityIndex), "Component does not exist in pool"); return getDense(m_sparse[entityIndex]); }
+			const T& operator [] (std::size_t entityIndex) const { XY_ASSERT(contains(entityIndex), "Component does not exist in pool"); return getDense(m_sparse[entityIndex]); }
+
+			T& at(std::size_t entityIndex) { XY_ASSERT(contains(entityIndex), "Component does not exist in pool"); return getDense(m_sparse.at(entityIndex)); }
+			const T& at(std::size_t entityIndex) const { XY_ASSERT(contains(entityIndex), "Component does not exist in pool"); return getDense(m_sparse.at(entityIndex)); }
+
+			/*!
+			\brief Returns the component at the given position in the dense array.
+			The order matches that of getEntityIndices()
+			*/
+			T& getDense(std::size_t denseIndex) { return *std::launder(reinterpret_cast<T*>(getSlot(denseIndex))); }
+			const T& getDense(std::size_t denseIndex) const { return *std::launder(reinterpret_cast<const T*>(getSlot(denseIndex))); }
+
+			/*!
+			\brief Returns the indices of the entities which own each of the
+			components in the dense array
+			*/
+			const std::vector<std::size_t>& getEntityIndices() const { return m_entities; }
 
 		private:
-			std::vector<T> m_pool;
+			struct Page final
+			{
+				typename std::aligned_storage<sizeof(T), alignof(T)>::type data[ComponentsPerPage];
+			};
+
+			std::vector<std::size_t> m_sparse;
+			std::vector<std::size_t> m_entities;
+			std::vector<std::unique_ptr<Page>> m_pages;
+			std::size_t m_size;
+
+			void* getSlot(std::size_t denseIndex) { return &m_pages[denseIndex / ComponentsPerPage]->data[denseIndex % ComponentsPerPage]; }
+			const void* getSlot(std::size_t denseIndex) const { return &m_pages[denseIndex / ComponentsPerPage]->data[denseIndex % ComponentsPerPage]; }
 		};
 	}
 }
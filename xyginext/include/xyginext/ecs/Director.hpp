@@ -30,6 +30,8 @@ source distribution.
 #include "xyginext/Config.hpp"
 #include "xyginext/core/MessageBus.hpp"
 
+#include <vector>
+
 namespace xy
 {
     class Message;
@@ -61,7 +63,9 @@ namespace xy
 
     protected:
         /*!
-        \brief Implement to handle system messages
+        \brief Implement to handle system messages.
+        Only messages with an ID to which the Director has
+        subscribed are forwarded to this function. \see subscribe()
         */
         virtual void handleMessage(const Message&) = 0;
 
@@ -75,6 +79,18 @@ namespace xy
         */
         virtual void process(float) {}
 
+        /*!
+        \brief Subscribes the Director to messages with the given ID.
+        Directors receive no messages in handleMessage() until they have
+        subscribed to at least one ID, usually in their constructor.
+        */
+        void subscribe(Message::ID id);
+
+        /*!
+        \brief Stops the Director receiving messages with the given ID
+        */
+        void unsubscribe(Message::ID id);
+
         /*
         \brief Places a message on the system wide MessageBus
         */
@@ -98,6 +114,8 @@ namespace xy
         CommandSystem* m_commandSystem;
         Scene* m_scene;
 
+        std::vector<Message::ID> m_subscriptions;
+
         friend class Scene;
     };
 
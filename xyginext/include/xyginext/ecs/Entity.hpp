@@ -37,9 +37,22 @@ source distribution.
 
 #include <bitset>
 #include <vector>
-#include <deque>
 #include <memory>
 #include <limits>
+#include <type_traits>
+
+//the number of bits of an entity ID used for the index and generation.
+//these must be the same for the library and any code which uses it, so
+//should be set via the XY_ENTITY_INDEX_BITS and XY_ENTITY_GENERATION_BITS
+//CMake options. IDs are 64 bit if the total exceeds 32 bits. The index
+//may use at most 31 bits, and the generation at most 32.
+#ifndef XY_ENTITY_INDEX_BITS
+#define XY_ENTITY_INDEX_BITS 20
+#endif
+
+#ifndef XY_ENTITY_GENERATION_BITS
+#define XY_ENTITY_GENERATION_BITS 12
+#endif
 
 namespace xy
 {
@@ -48,10 +61,14 @@ namespace xy
 		enum
 		{
 			MaxComponents = 64, //this is max number of types on a single entity (and max bits in a bitset)
-			IndexBits = 24,
-			GenerationBits = 8,
-			MaxIDsPerGeneration = 1024 //max number of IDs (and therefore max component buffer size) to generate before looking to recycle ID
+			IndexBits = XY_ENTITY_INDEX_BITS,
+			GenerationBits = XY_ENTITY_GENERATION_BITS,
+			MinFreeIDs = 1024 //min number of destroyed IDs to accumulate before looking to recycle them, which spreads generation use across IDs
 		};
+
+		static_assert(IndexBits > 0 && GenerationBits > 0 && (IndexBits + GenerationBits) <= 64, "Invalid entity ID bit widths");
+		static_assert(IndexBits <= 31, "Entity indices are limited to 31 bits so that they fit in Message::SceneEvent::entityID");
+		static_assert(GenerationBits <= 32, "Entity generation is limited to 32 bits");
 	}
 	
 	using ComponentMask = std::bitset<Detail::MaxComponents>;
@@ -66,8 +83,9 @@ namespace xy
 	class XY_EXPORT_API Entity final
 	{
 	public:
-		using ID = sf::Uint32;
-		using Generation = sf::Uint8;
+		using ID = std::conditional<(Detail::IndexBits + Detail::GenerationBits) <= 32, sf::Uint32, sf::Uint64>::type;
+		using Generation = std::conditional<Detail::GenerationBits <= 8, sf::Uint8,
+			std::conditional<Detail::GenerationBits <= 16, sf::Uint16, sf::Uint32>::type>::type;
 
 		Entity(ID index = std::numeric_limits<ID>::max(), Generation generation = 0);
 
@@ -168,6 +186,9 @@ namespace xy
 
     class ComponentManager;
     class MessageBus;
+    template <typename... Ts>
+    class View;
+
     /*!
     \brief Manages the relationship between an Entity and its components
     */
@@ -238,14 +259,28 @@ namespace xy
     private:
         MessageBus& m_messageBus;
         ComponentManager& m_componentManager;
-        std::deque<Entity::ID> m_freeIDs;
-        std::vector<Entity::Generation> m_generations; // < indexed by entity ID
+
+        //slots form an intrusive FIFO list of destroyed IDs
+        //so that IDs are recycled in the order they were freed
+        struct Slot final
+        {
+            Entity::Generation generation = 0;
+            Entity::ID nextFree = std::numeric_limits<Entity::ID>::max();
+        };
+        std::vector<Slot> m_slots; // < indexed by entity ID
+        Entity::ID m_freeHead;
+        Entity::ID m_freeTail;
+        std::size_t m_freeCount;
+
         std::vector<std::unique_ptr<Detail::Pool>> m_componentPools; // < index is component ID. Pool index is entity ID.
         std::size_t m_initialPoolSize;
         std::vector<ComponentMask> m_componentMasks;
 
         template <typename T>
         Detail::ComponentPool<T>& getPool();
+
+        template <typename... Ts>
+        friend class View;
     };
 
 #include "Entity.inl"
@@ -34,22 +34,20 @@ void EntityManager::addComponent(Entity entity, T component)
     auto entID = entity.getIndex();
 
     auto& pool = getPool<T>();
-    if (entID >= pool.size())
-    {
-        //should never need to be bigger than this
-        pool.resize(Detail::MaxIDsPerGeneration);
-    }
-
-    pool[entID] = std::move(component);
+    pool.insert(entID, std::move(component));
     m_componentMasks[entID].set(componentID);
 }
 
 template <typename T, typename... Args>
 T& EntityManager::addComponent(Entity entity, Args&&... args)
 {
-    T component(std::forward<Args>(args)...);
-    addComponent<T>(entity, std::move(component));
-    return getComponent<T>(entity);
+    auto componentID = m_componentManager.getID<T>();
+    auto entID = entity.getIndex();
+
+    auto& pool = getPool<T>();
+    auto& component = pool.insert(entID, T(std::forward<Args>(args)...));
+    m_componentMasks[entID].set(componentID);
+    return component;
 }
 
 //TODO this doesn't remove the entity from active systems...
@@ -84,10 +82,10 @@ T& EntityManager::getComponent(Entity entity)
 
 
     XY_ASSERT(componentID < m_componentPools.size(), "Component index out of range");
-    auto* pool = (dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
+    auto* pool = static_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get());
 
-    XY_ASSERT(entityID < pool->size(), "Entity index out of range");
-    return pool->at(entityID);
+    XY_ASSERT(pool->contains(entityID), "Entity index out of range");
+    return (*pool)[entityID];
 }
 
 template <typename T>
@@ -100,5 +98,5 @@ Detail::ComponentPool<T>& EntityManager::getPool()
         m_componentPools[componentID] = std::make_unique<Detail::ComponentPool<T>>(m_initialPoolSize);
     }
 
-    return *(dynamic_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get()));
+    return *static_cast<Detail::ComponentPool<T>*>(m_componentPools[componentID].get());
 }
\ No newline at end of file
@@ -32,6 +32,7 @@ source distribution.
 #include "xyginext/ecs/Entity.hpp"
 #include "xyginext/ecs/Component.hpp"
 #include "xyginext/ecs/System.hpp"
+#include "xyginext/ecs/View.hpp"
 #include "xyginext/ecs/systems/CommandSystem.hpp"
 #include "xyginext/ecs/Director.hpp"
 #include "xyginext/graphics/postprocess/PostProcess.hpp"
@@ -64,11 +65,10 @@ namespace xy
         \brief Constructor.
         \param messageBus Reference to the active message bus
         \param initialPoolSize Components are pooled in memory, and this
-        is the initial number of components for which memory is allocated.
-        Memory pools will resize at runtime if necessary, but an initial
-        size can be set here. The default is 256 components. As the maximum
-        number of entity IDs is 1024 before they are recycled, values greater
-        than this have no effect other than allocating unusable memory.
+        is the initial number of components of each type for which book-keeping
+        memory is reserved. Pools only allocate component memory for entities
+        which actually have them, in pages which are added as the pool grows,
+        so existing components are never relocated. The default is 256 components.
         */
         Scene(MessageBus& messageBus, std::size_t initialPoolSize = 256);
 
@@ -100,6 +100,14 @@ namespace xy
         */
         Entity getEntity(Entity::ID) const;
 
+        /*!
+        \brief Returns a View of all the entities in the Scene which have
+        all of the given component types.
+        \see View
+        */
+        template <typename... Ts>
+        View<Ts...> view();
+
         /*!
         \brief Creates a new system of the given type.
         All systems need to be fully created before adding entities, else
@@ -125,6 +133,16 @@ namespace xy
         template <typename T>
         void setSystemActive(bool active);
 
+        /*!
+        \brief Enables or disables processing systems in parallel.
+        When enabled, systems marked as concurrent whose declared component
+        access does not conflict are processed at the same time on worker
+        threads. When disabled all systems are processed serially, in the
+        order in which they were added. Enabled by default.
+        \see System::setConcurrent()
+        */
+        void setParallelProcessing(bool enabled);
+
         /*!
         \brief Adds a Director to the Scene.
         Directors are used to control in game entities and events through
@@ -187,7 +205,8 @@ namespace xy
         void forwardEvent(const sf::Event&);
 
         /*!
-        \brief Forwards messages to the systems in the scene
+        \brief Forwards messages to the systems and Directors in the
+        scene which have subscribed to the message ID
         */
         void forwardMessage(const Message&);
 
@@ -205,11 +224,17 @@ namespace xy
         SystemManager m_systemManager;
 
         std::vector<std::unique_ptr<Director>> m_directors;
+        bool m_directorSubscribersDirty;
+        std::vector<std::vector<Director*>> m_directorSubscribers; //< directors subscribed to each message ID
+        void buildDirectorSubscribers();
+        friend class Director;
 
         std::vector<sf::Drawable*> m_drawables;
 
-        sf::RenderTexture m_sceneBuffer;
-        std::array<sf::RenderTexture, 2u> m_postBuffers;
+        //buffers are created with the first post process so that scenes which
+        //don't use them, such as those run by a server, need no OpenGL context
+        std::unique_ptr<sf::RenderTexture> m_sceneBuffer;
+        std::array<std::unique_ptr<sf::RenderTexture>, 2u> m_postBuffers;
         std::vector<std::unique_ptr<PostProcess>> m_postEffects;
 
         void postRenderPath(sf::RenderTarget&, sf::RenderStates);
@@ -26,6 +26,12 @@ source distribution.
 *********************************************************************/
 
 
+template <typename... Ts>
+View<Ts...> Scene::view()
+{
+    return View<Ts...>(m_entityManager);
+}
+
 template <typename T, typename... Args>
 T& Scene::addSystem(Args&&... args)
 {
@@ -64,6 +70,7 @@ void Scene::addDirector(Args&&... args)
     m_directors.back()->m_commandSystem = &m_systemManager.getSystem<CommandSystem>();
     m_directors.back()->m_messageBus = &m_messageBus;
     m_directors.back()->m_scene = this;
+    m_directorSubscribersDirty = true;
 }
 
 template <typename T, typename... Args>
@@ -73,7 +80,12 @@ T& Scene::addPostProcess(Args&&... args)
     auto size = App::getRenderWindow()->getSize();
     if (m_postEffects.empty())
     {
-        if (m_sceneBuffer.create(size.x, size.y))
+        if (!m_sceneBuffer)
+        {
+            m_sceneBuffer = std::make_unique<sf::RenderTexture>();
+        }
+
+        if (m_sceneBuffer->create(size.x, size.y))
         {
             //set render path
             currentRenderPath = std::bind(&Scene::postRenderPath, this, std::placeholders::_1, std::placeholders::_2);
@@ -90,10 +102,12 @@ T& Scene::addPostProcess(Args&&... args)
     switch (m_postEffects.size())
     {
     case 2:
-        m_postBuffers[0].create(size.x, size.y);
+        m_postBuffers[0] = std::make_unique<sf::RenderTexture>();
+        m_postBuffers[0]->create(size.x, size.y);
         break;
     case 3:
-        m_postBuffers[1].create(size.x, size.y);
+        m_postBuffers[1] = std::make_unique<sf::RenderTexture>();
+        m_postBuffers[1]->create(size.x, size.y);
         break;
     default: break;
     }
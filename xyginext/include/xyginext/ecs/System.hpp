@@ -30,6 +30,7 @@ source distribution.
 #include "xyginext/Config.hpp"
 #include "xyginext/ecs/Entity.hpp"
 #include "xyginext/ecs/Component.hpp"
+#include "xyginext/ecs/View.hpp"
 #include "xyginext/core/MessageBus.hpp"
 
 #include <vector>
@@ -39,9 +40,20 @@ namespace xy
 {
     class Scene;
     class ComponentManager;
+    class SystemManager;
 
     using UniqueType = std::type_index;
 
+    /*!
+    \brief Describes how a System accesses a type of component.
+    This is used by the SystemManager to decide which systems may
+    be processed concurrently.
+    */
+    enum class ComponentAccess
+    {
+        Read, Write
+    };
+
     /*!
     \brief Base class for systems.
     Systems should all derive from this base class, and instanciated before any entities
@@ -60,7 +72,7 @@ namespace xy
         a unique type ID for this system.
         */
         System(MessageBus& mb, UniqueType t) 
-            : m_messageBus(mb), m_type(t), m_scene(nullptr), m_active(false){}
+            : m_messageBus(mb), m_type(t), m_scene(nullptr), m_entityManager(nullptr), m_systemManager(nullptr), m_active(false), m_stableRemoval(false), m_concurrent(false){}
 
         virtual ~System() = default;
 
@@ -72,7 +84,7 @@ namespace xy
         /*!
         \brief Returns a list of entities that this system is currently interested in
         */
-        std::vector<Entity> getEntities() const;
+        const std::vector<Entity>& getEntities() const;
 
         /*!
         \brief Adds an entity to the list to process
@@ -80,10 +92,18 @@ namespace xy
         void addEntity(Entity);
 
         /*!
-        \brief Removes an entity from the list to process
+        \brief Removes an entity from the list to process.
+        By default the last entity in the list is swapped into the
+        position of the removed entity, so removal is O(1) but does
+        not preserve the order of the list. \see setStableRemoval()
         */
         void removeEntity(Entity);
 
+        /*!
+        \brief Returns true if the given entity is in the list to process
+        */
+        bool hasEntity(Entity) const;
+
         /*!
         \brief Returns the component mask used to mask entities with corresponding
         components for this system to process
@@ -91,7 +111,9 @@ namespace xy
         const ComponentMask& getComponentMask() const;
 
         /*!
-        \brief Used to process any incoming system messages
+        \brief Used to process any incoming system messages.
+        Only messages with an ID to which the system has subscribed
+        are forwarded to this function. \see subscribe()
         */
         virtual void handleMessage(const Message&);
 
@@ -106,18 +128,96 @@ namespace xy
         */
         bool isActive() const { return m_active; }
 
+        /*!
+        \brief Returns true if the system has declared that it is safe to
+        process concurrently with other systems. \see setConcurrent()
+        */
+        bool isConcurrent() const { return m_concurrent; }
+
+        /*!
+        \brief Returns the mask of component types this system reads
+        */
+        const ComponentMask& getReadMask() const { return m_readMask; }
+
+        /*!
+        \brief Returns the mask of component types this system writes
+        */
+        const ComponentMask& getWriteMask() const { return m_writeMask; }
+
     protected:
 
         /*!
         \brief Adds a component type to the list of components required by the
         system for it to be interested in a particular entity. This should only
         be used in the constructor of the System else types will not be registered.
+        \param access Whether the system only reads this component type or
+        also writes to it during process(). Defaults to Write.
+        */
+        template <typename T>
+        void requireComponent(ComponentAccess access = ComponentAccess::Write);
+
+        /*!
+        \brief Declares access to a component type which the system uses
+        during process() but does not require, for example the Transform of
+        a parent or of the active camera. Like requireComponent() this should
+        only be used in the constructor of the System.
         */
         template <typename T>
-        void requireComponent();
+        void useComponent(ComponentAccess access);
+
+        /*!
+        \brief Marks this system as safe to process concurrently with other
+        systems whose declared component access does not conflict with its own.
+        Concurrent systems must only access the components they have declared
+        with requireComponent() or useComponent(), must only read shared state
+        from the Scene and must not create or destroy entities or add components
+        from process(). Messages must be posted with MessageBus::postFromThread()
+        rather than postMessage(). Systems are not concurrent by default.
+        */
+        void setConcurrent(bool concurrent) { m_concurrent = concurrent; }
+
+        /*!
+        \brief Systems which rely on the order of their entity list,
+        for example because they depth sort it or select entities by
+        index, should set this to true in their constructor. Removing
+        an entity will then preserve the order of the remaining entities,
+        at the cost of O(n) removal.
+        */
+        void setStableRemoval(bool stable) { m_stableRemoval = stable; }
+
+        /*!
+        \brief Subscribes the system to messages with the given ID.
+        Systems receive no messages in handleMessage() until they have
+        subscribed to at least one ID, usually in their constructor.
+        */
+        void subscribe(Message::ID id);
+
+        /*!
+        \brief Stops the system receiving messages with the given ID
+        */
+        void unsubscribe(Message::ID id);
 
         std::vector<Entity>& getEntities() { return m_entities; }
 
+        /*!
+        \brief Calls the given function for each of the system's entities,
+        in order, passing references to the requested components.
+        The function signature should be void(Entity, Ts&...). The component
+        pools are looked up once per call, rather than once per entity,
+        so this is preferable to calling Entity::getComponent() in a loop.
+        All of the requested types should also be required by the system
+        with requireComponent().
+        */
+        template <typename... Ts, typename Fn>
+        void each(Fn&& fn);
+
+        /*!
+        \brief Const overload of each(). The function signature should be
+        void(Entity, const Ts&...)
+        */
+        template <typename... Ts, typename Fn>
+        void each(Fn&& fn) const;
+
         /*!
         \brief Optional callback performed when an entity is added
         */
@@ -156,22 +256,46 @@ namespace xy
 
         ComponentMask m_componentMask;
         std::vector<Entity> m_entities;
+        std::vector<std::size_t> m_entityIndices; //< position in m_entities, indexed by entity index
 
         Scene* m_scene;
+        EntityManager* m_entityManager;
+        SystemManager* m_systemManager;
+
+        std::vector<Message::ID> m_subscriptions;
 
         bool m_active; //used by system manager to check if it has been added to the active list
+        bool m_stableRemoval;
+        bool m_concurrent;
+
+        ComponentMask m_readMask;
+        ComponentMask m_writeMask;
         friend class SystemManager;
 
         //list of types populated by requireComponent then processed by SystemManager
         //when the system is created
-        std::vector<std::type_index> m_pendingTypes;
-        void processTypes(ComponentManager&);
+        struct PendingType final
+        {
+            std::type_index type;
+            ComponentAccess access = ComponentAccess::Write;
+            bool required = true;
+            void(*initPool)(EntityManager&) = nullptr;
+        };
+        std::vector<PendingType> m_pendingTypes;
+        void processTypes(ComponentManager&, EntityManager&);
+
+        //makes sure a pool exists before systems are processed
+        //so that concurrent systems never create one
+        template <typename T>
+        static void initPool(EntityManager&);
+
+        void rebuildEntityIndices();
     };
 
     class XY_EXPORT_API SystemManager final
     {
     public:
-        SystemManager(Scene&, ComponentManager&);
+        SystemManager(Scene&, ComponentManager&, EntityManager&);
 
         ~SystemManager() = default;
         SystemManager(const SystemManager&) = delete;
@@ -226,19 +350,50 @@ namespace xy
         void removeFromSystems(Entity);
 
         /*!
-        \brief Forwards messages to all systems
+        \brief Forwards messages to all systems which have subscribed to the message ID
         */
         void forwardMessage(const Message&);
 
         /*!
-        \brief Runs a simulation step by calling process() on each system
+        \brief Runs a simulation step by calling process() on each system.
+        If parallel processing is enabled systems which are marked as concurrent,
+        and whose declared component access does not conflict, are processed
+        at the same time using the JobSystem. Systems which conflict
+        are always processed in the order in which they were added.
         */
         void process(float);
+
+        /*!
+        \brief Enables or disables parallel processing of systems.
+        When disabled, or when the JobSystem has no workers, all systems
+        are processed serially on the calling thread in the order in which
+        they were added. Enabled by default.
+        */
+        void setParallelProcessing(bool enabled);
+
+        /*!
+        \brief Returns true if parallel processing of systems is enabled
+        */
+        bool getParallelProcessing() const { return m_parallelProcessing; }
+
     private:
+        friend class System;
+
         Scene& m_scene;
         ComponentManager& m_componentManager;
+        EntityManager& m_entityManager;
         std::vector<std::unique_ptr<System>> m_systems;
         std::vector<System*> m_activeSystems;
+        std::vector<std::vector<System*>> m_entitySystems; //< systems each entity belongs to, indexed by entity index
+
+        bool m_parallelProcessing;
+        bool m_scheduleDirty;
+        std::vector<std::vector<System*>> m_schedule; //< groups of active systems which can be processed concurrently
+        void buildSchedule();
+
+        bool m_subscribersDirty;
+        std::vector<std::vector<System*>> m_messageSubscribers; //< systems subscribed to each message ID, in the order they were added
+        void buildSubscribers();
 
         template <typename T>
         void removeFromActive();
@@ -26,13 +26,43 @@ source distribution.
 *********************************************************************/
 
 template <typename T>
-void System::requireComponent()
+void System::requireComponent(ComponentAccess access)
 {
-    m_pendingTypes.push_back(typeid(T));
+    m_pendingTypes.push_back({ typeid(T), access, true, &System::initPool<T> });
+}
+
+template <typename T>
+void System::useComponent(ComponentAccess access)
+{
+    m_pendingTypes.push_back({ typeid(T), access, false, &System::initPool<T> });
+}
+
+template <typename T>
+void System::initPool(EntityManager& em)
+{
+    View<T> view(em);
 }
 
 template <typename T>
 T* System::postMessage(Message::ID id)
 {
     return m_messageBus.post<T>(id);
+}
+
+template <typename... Ts, typename Fn>
+void System::each(Fn&& fn)
+{
+    XY_ASSERT(m_entityManager, "System has not been added to a Scene");
+    View<Ts...>(*m_entityManager).each(m_entities, std::forward<Fn>(fn));
+}
+
+template <typename... Ts, typename Fn>
+void System::each(Fn&& fn) const
+{
+    XY_ASSERT(m_entityManager, "System has not been added to a Scene");
+    View<Ts...>(*m_entityManager).each(m_entities, 
+        [&fn](Entity entity, const Ts&... components)
+    {
+        fn(entity, components...);
+    });
 }
\ No newline at end of file
@@ -44,9 +44,13 @@ T& SystemManager::addSystem(Args&&... args)
 
     m_systems.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
     m_systems.back()->setScene(m_scene);
-    m_systems.back()->processTypes(m_componentManager);
+    m_systems.back()->m_entityManager = &m_entityManager;
+    m_systems.back()->m_systemManager = this;
+    m_systems.back()->processTypes(m_componentManager, m_entityManager);
     m_activeSystems.push_back(m_systems.back().get());
     m_systems.back()->m_active = true;
+    m_scheduleDirty = true;
+    m_subscribersDirty = true;
 
     return *(dynamic_cast<T*>(m_systems.back().get()));
 }
@@ -55,13 +59,37 @@ template <typename T>
 void SystemManager::removeSystem()
 {
     UniqueType type(typeid(T));
+
+    //remove the system from the membership lists of its entities
+    auto result = std::find_if(std::begin(m_systems), std::end(m_systems),
+        [&type](const System::Ptr& sys)
+    {
+        return sys->getType() == type;
+    });
+
+    if (result != m_systems.end())
+    {
+        auto* system = result->get();
+        for (const auto& entity : system->m_entities)
+        {
+            if (entity.getIndex() < m_entitySystems.size())
+            {
+                auto& systems = m_entitySystems[entity.getIndex()];
+                systems.erase(std::remove(systems.begin(), systems.end(), system), systems.end());
+            }
+        }
+    }
+
+    //remove from the active list first, as it dereferences the system
+    removeFromActive<T>();
+
     m_systems.erase(std::remove_if(std::begin(m_systems), std::end(m_systems),
         [&type](const System::Ptr& sys) 
     {
         return sys->getType() == type;
     }), std::end(m_systems));
 
-    removeFromActive<T>();
+    m_subscribersDirty = true;
 }
 
 template <typename T>
@@ -81,6 +109,7 @@ void SystemManager::setSystemActive(bool active)
         {
             removeFromActive<T>();
             (*result)->m_active = false;
+            m_scheduleDirty = true;
         }
         else
         {
@@ -89,6 +118,7 @@ void SystemManager::setSystemActive(bool active)
             {
                 m_activeSystems.push_back((*result).get());
                 (*result)->m_active = true;
+                m_scheduleDirty = true;
             }
         }
     }
@@ -132,4 +162,5 @@ void SystemManager::removeFromActive()
     {
         return sys->getType() == type;
     }), std::end(m_activeSystems));
+    m_scheduleDirty = true;
 }
\ No newline at end of file
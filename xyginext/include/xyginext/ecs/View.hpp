@@ -0,0 +1,122 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include "xyginext/ecs/Entity.hpp"
+#include "xyginext/ecs/ComponentPool.hpp"
+
+#include <tuple>
+#include <vector>
+
+namespace xy
+{
+    /*!
+    \brief Provides typed access to entities which have all of the given
+    component types.
+    The component pools are resolved once when the View is created, so
+    iterating a View costs a single pool lookup per component per entity,
+    rather than a type ID lookup for every call to Entity::getComponent().
+    Views are lightweight and are intended to be created when they are
+    needed, for example via Scene::view<Transform, Sprite>(), or via
+    System::each<Transform, Sprite>() from within a System.
+    Adding components of the viewed types to other entities while
+    iterating a View is not supported, as it may relocate components.
+    */
+    template <typename... Ts>
+    class View final
+    {
+    public:
+        static_assert(sizeof...(Ts) > 0, "View requires at least one component type");
+
+        explicit View(EntityManager& em)
+            : m_entityManager   (em),
+            m_pools             (&em.getPool<Ts>()...)
+        {
+
+        }
+
+        /*!
+        \brief Calls the given function for every entity in the scene which
+        has all of the View's component types.
+        The function signature should be void(Entity, Ts&...)
+        */
+        template <typename Fn>
+        void each(Fn&& fn)
+        {
+            const auto& indices = getSmallestPool();
+            for (auto i = 0u; i < indices.size(); ++i)
+            {
+                const auto index = indices[i];
+                if ((std::get<Detail::ComponentPool<Ts>*>(m_pools)->contains(index) && ...))
+                {
+                    fn(m_entityManager.getEntity(static_cast<Entity::ID>(index)),
+                        (*std::get<Detail::ComponentPool<Ts>*>(m_pools))[index]...);
+                }
+            }
+        }
+
+        /*!
+        \brief Calls the given function for each of the given entities, in order.
+        All of the entities are expected to have all of the View's component types,
+        for example the list of entities returned by System::getEntities() of a
+        System which requires the same components.
+        The function signature should be void(Entity, Ts&...)
+        */
+        template <typename Fn>
+        void each(const std::vector<Entity>& entities, Fn&& fn)
+        {
+            for (auto entity : entities)
+            {
+                const auto index = entity.getIndex();
+                fn(entity, (*std::get<Detail::ComponentPool<Ts>*>(m_pools))[index]...);
+            }
+        }
+
+        /*!
+        \brief Returns the component of the given type belonging to the given Entity.
+        The type must be one of the View's component types.
+        */
+        template <typename T>
+        T& get(Entity entity)
+        {
+            return (*std::get<Detail::ComponentPool<T>*>(m_pools))[entity.getIndex()];
+        }
+
+    private:
+        EntityManager& m_entityManager;
+        std::tuple<Detail::ComponentPool<Ts>*...> m_pools;
+
+        const std::vector<std::size_t>& getSmallestPool() const
+        {
+            const std::vector<std::size_t>* smallest = nullptr;
+            ((smallest = (!smallest || std::get<Detail::ComponentPool<Ts>*>(m_pools)->size() < smallest->size())
+                ? &std::get<Detail::ComponentPool<Ts>*>(m_pools)->getEntityIndices() : smallest), ...);
+            return *smallest;
+        }
+    };
+}
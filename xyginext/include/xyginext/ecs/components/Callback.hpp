@@ -29,6 +29,8 @@ source distribution.
 
 #include "xyginext/Config.hpp"
 
+#include <SFML/Config.hpp>
+
 #include <functional>
 #include <any>
 
@@ -39,6 +41,11 @@ namespace xy
     using CallbackFunction = std::function<void(Entity, float)>;
     /*!
     \brief Allows attaching a callback function to an entity.
+    Callbacks which only need to run after a delay can be put to sleep
+    with sleepFor() or wakeAt(), rather than counting down a timer each
+    frame. Sleeping callbacks are not visited by the CallbackSystem at
+    all until they wake, after which the function is called every frame
+    as usual, if the callback is active.
     \see CallbackSystem
     */
     struct XY_EXPORT_API Callback final
@@ -46,5 +53,39 @@ namespace xy
         bool active = false; //!< disabling callbacks when not in use can avoid unnecessary cache misses looking up callback functions
         CallbackFunction function;
         std::any userData; //!< Optionally store any data required by the function here (or use a functor)
+
+        /*!
+        \brief Stops the function being called for the given number of seconds.
+        The request is applied by the CallbackSystem after the function
+        returns, if called from within the function, else the next time
+        the CallbackSystem is processed. Sleep times are rounded up to the
+        next 1/60th of a second. Requests made while the callback is already
+        sleeping are applied once it wakes.
+        */
+        void sleepFor(float seconds) { m_sleepRequest = SleepRequest::For; m_sleepTime = seconds; }
+
+        /*!
+        \brief Stops the function being called until the CallbackSystem time
+        reaches the given value.
+        \see CallbackSystem::getTime()
+        */
+        void wakeAt(float time) { m_sleepRequest = SleepRequest::At; m_sleepTime = time; }
+
+        /*!
+        \brief Returns true if the callback is currently sleeping.
+        Use CallbackSystem::wake() to wake a sleeping callback early.
+        */
+        bool isSleeping() const { return m_sleeping; }
+
+    private:
+        enum class SleepRequest : sf::Uint8
+        {
+            None, For, At
+        };
+        SleepRequest m_sleepRequest = SleepRequest::None;
+        bool m_sleeping = false;
+        float m_sleepTime = 0.f;
+
+        friend class CallbackSystem;
     };
 }
@@ -28,11 +28,14 @@ source distribution.
 #pragma once
 
 #include "xyginext/Config.hpp"
+#include "xyginext/ecs/Entity.hpp"
 
 #include <SFML/Config.hpp>
 
 namespace xy
 {
+    class CommandSystem;
+
     /*!
     \brief Attaches a command ID bitmask to an Entity.
     ID should be a bit mask of flags representing target IDs.
@@ -43,7 +46,7 @@ namespace xy
         Player = 0x1, Enemy = 0x2, NPC = 0x4
     };
 
-    CommandTarget target; target.ID |= Enemy | NPC;
+    CommandTarget target; target.setID(Enemy | NPC);
 
     The command target system will then apply any given commands to targets
     whose flags match one or more of the flags belonging to the command.
@@ -51,6 +54,26 @@ namespace xy
     */
     struct XY_EXPORT_API CommandTarget final
     {
-        sf::Uint32 ID = 0;
+        /*!
+        \brief Sets the command ID bitmask.
+        Once the entity has been added to a CommandSystem, the system is
+        notified of the change and re-sorts the entity before it executes
+        the next command, including commands sent in the same frame.
+        This is not thread safe.
+        */
+        void setID(sf::Uint32 id);
+
+        /*!
+        \brief Returns the command ID bitmask
+        */
+        sf::Uint32 getID() const { return m_id; }
+
+    private:
+        sf::Uint32 m_id = 0;
+        CommandSystem* m_commandSystem = nullptr;
+        Entity m_entity;
+        bool m_dirty = false;
+
+        friend class CommandSystem;
     };
 }
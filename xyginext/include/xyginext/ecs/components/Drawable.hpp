@@ -28,6 +28,7 @@ source distribution.
 #pragma once
 
 #include "xyginext/Config.hpp"
+#include "xyginext/graphics/Material.hpp"
 
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/Vertex.hpp>
@@ -38,7 +39,7 @@ source distribution.
 
 #include <vector>
 #include <string>
-#include <array>
+#include <optional>
 
 namespace xy
 {
@@ -67,18 +68,36 @@ namespace xy
 
         /*!
         \brief Sets the shader used when drawing.
-        Passing nullptr removes any active shader.
+        Passing nullptr removes any active shader. This also removes
+        any Material which may have been set.
         */
         void setShader(sf::Shader*);
 
+        /*!
+        \brief Sets a Material with which to draw this drawable.
+        The Drawable's shader is set to that of the Material, and the
+        Material's uniform values are applied before any bound to the
+        drawable with bindUniform(). Materials may be shared between
+        any number of drawables, and must outlive them. Passing nullptr
+        removes the material (but not the shader).
+        */
+        void setMaterial(const Material*);
+
+        /*!
+        \brief Returns a pointer to the active Material, if any
+        */
+        const Material* getMaterial() const { return m_material; }
+
         /*!
         \brief Adds a uniform binding to be applied to any shader this
         drawable may have.
         When sharing a shader between multiple drawables it may be, for
         instance, desirable to the apply a different texture for each drawble.
         This function allows mapping a uniform name (assuming it is available
-        in the current shader) to a texture or other value.
-        Bindings are limited to 6 per type.
+        in the current shader) to a texture or other value. These values
+        override any set by the active Material. Drawables with bound uniforms
+        are never batched, so values shared between drawables are better
+        set on a Material.
         */
         void bindUniform(const std::string& name, const sf::Texture& texture);
 
@@ -99,7 +118,6 @@ namespace xy
 
         /*!
         \brief Binds the given uniform to the value of sf::Shader::CurrentTexture.
-        Up to 6 uniforms may be bound to this value.
         */
         void bindUniformToCurrentTexture(const std::string& name);
 
@@ -193,6 +211,27 @@ namespace xy
         */
         void setCulled(bool cull) { m_cull = cull; }
 
+        /*!
+        \brief Marks this drawable as static geometry.
+        The vertices of static drawables are transformed to world space and
+        stored in a vertex buffer, shared with other nearby static drawables
+        which have the same depth, texture, shader and blend mode. The buffer
+        is only uploaded again when one of its drawables is moved or modified,
+        which greatly reduces the amount of vertex data sent each frame for
+        unchanging scenery such as tile maps. After modifying the vertices of
+        a static drawable updateLocalBounds() must be called for the change to
+        be uploaded. Drawables which are cropped, have uniforms bound to them
+        or use strip or fan primitive types are drawn as normal.
+        Default value is false.
+        */
+        void setStatic(bool isStatic) { m_static = isStatic; }
+
+        /*!
+        \brief Returns true if this drawable is marked as static geometry
+        \see setStatic()
+        */
+        bool isStatic() const { return m_static; }
+
         /*!
         \brief Returns the RenderStates containing the current blend mode,
         PrimitiveType and Shader of the drawable.
@@ -201,10 +240,12 @@ namespace xy
         sf::RenderStates getStates() const;
 
         /*!
-        \brief Applies all the unform bindings to the current shader.
+        \brief Applies the active Material, if any, followed by all the
+        uniform bindings to the current shader.
         Generally not used unless implementing a custom render system,
         in which case this should be called immediately before the
-        component is drawn.
+        component is drawn, with the shader's program bound.
+        \see Material::apply()
         */
         void applyShader() const;
 
@@ -214,29 +255,16 @@ namespace xy
         std::vector<sf::Vertex> m_vertices;
 
         sf::Int32 m_zDepth = 0;
-        bool m_wantsSorting = true;
 
         sf::FloatRect m_localBounds;
+        sf::Uint32 m_boundsVersion; //incremented when the local bounds change
+        sf::Uint32 m_vertexVersion; //incremented when the local bounds are updated
 
-        static constexpr std::size_t MaxBindings = 6;
-        std::array<std::pair<std::string, const sf::Texture*>, MaxBindings> m_textureBindings;
-        std::array<std::pair<std::string, float>, MaxBindings> m_floatBindings;
-        std::array<std::pair<std::string, sf::Vector2f>, MaxBindings> m_vec2Bindings;
-        std::array<std::pair<std::string, sf::Vector3f>, MaxBindings> m_vec3Bindings;
-        std::array<std::pair<std::string, bool>, MaxBindings> m_boolBindings;
-        std::array<std::pair<std::string, sf::Glsl::Vec4>, MaxBindings> m_colourBindings;
-        std::array<std::pair<std::string, const float*>, MaxBindings> m_matBindings;
-        std::array<std::string, MaxBindings> m_currentTexBindings;
-        std::size_t m_textureCount;
-        std::size_t m_floatCount;
-        std::size_t m_vec2Count;
-        std::size_t m_vec3Count;
-        std::size_t m_boolCount;
-        std::size_t m_colourCount;
-        std::size_t m_matCount;
-        std::size_t m_currentTexCount;
+        const Material* m_material;
+        std::optional<Material> m_uniformOverrides;
 
         bool m_cull;
+        bool m_static;
 
         sf::FloatRect m_croppingArea;
         sf::FloatRect m_croppingWorldArea;
@@ -244,6 +272,13 @@ namespace xy
 
         friend class RenderSystem;
 
+        bool hasUniformBindings() const
+        {
+            return m_uniformOverrides && !m_uniformOverrides->empty();
+        }
+
+        Material& getUniformOverrides();
+
         void draw(sf::RenderTarget&, sf::RenderStates) const override;
     };
 }
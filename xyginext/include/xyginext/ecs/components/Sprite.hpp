@@ -29,11 +29,12 @@ source distribution.
 
 #include "xyginext/Config.hpp"
 #include "xyginext/resources/ResourceHandler.hpp"
+#include "xyginext/graphics/AnimationSet.hpp"
 
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 
-#include <array>
+#include <memory>
 
 namespace sf
 {
@@ -107,52 +108,35 @@ namespace xy
         */
         sf::Vector2f getSize() const { return { m_textureRect.width, m_textureRect.height }; }
 
-        /*!
-        \brief Maximum number of frames in an animation
-        */
-        static constexpr std::size_t MaxFrames = 64;
-
-        /*!
-        \brief Maximum number of animations per sprite
-        */
-        static constexpr std::size_t MaxAnimations = 32;
-
         /*!
         \brief Represents a single animation
         */
-        struct Animation final
-        {
-            /*!
-            \brief Maximum  length of animation id
-            */
-            static constexpr std::size_t MaxAnimationIdLength = 32;
-            
-            std::array<char,MaxAnimationIdLength> id = {{0}};
-            std::array<sf::FloatRect, MaxFrames> frames;
-            std::size_t frameCount = 0;
-            std::uint32_t loopStart = 0; //!< looped animations can jump to somewhere other than the beginning
-            bool looped = false;
-            float framerate = 12.f;
-        };
-
+        using Animation = AnimationSet::Animation;
 
         /*!
         \brief Returns the number of animations for this sprite when loaded
         from a sprite sheet definition file.
         */
-        std::size_t getAnimationCount() const { return m_animationCount; }
+        std::size_t getAnimationCount() const { return m_animations ? m_animations->getAnimationCount() : 0; }
+
+        /*!
+        \brief Returns the sprite's animations.
+        Animations are shared between all sprites created from the same
+        sprite sheet entry, so are read only. Use setAnimationSet() to
+        give this sprite a modified copy.
+        */
+        const std::vector<Animation>& getAnimations() const;
 
         /*!
-        /brief Returns a reference to the sprites animation array.
-        Use getAnimationCount() to check how many of the animations are valid
+        \brief Sets the animations used by this sprite.
+        Passing nullptr removes all animations.
         */
-        std::array<Animation, MaxAnimations>& getAnimations() { return m_animations; }
+        void setAnimationSet(std::shared_ptr<const AnimationSet> animations) { m_animations = std::move(animations); }
 
         /*!
-        /brief Returns a const reference to the sprites animation array.
-        Use getAnimationCount() to check how many of the animations are valid
+        \brief Returns the shared AnimationSet used by this sprite, if any.
         */
-        const std::array<Animation, MaxAnimations>& getAnimations() const { return m_animations; }
+        const std::shared_ptr<const AnimationSet>& getAnimationSet() const { return m_animations; }
 
     private:
 
@@ -162,8 +146,7 @@ namespace xy
         sf::Color m_colour;
         bool m_dirty;
 
-        std::size_t m_animationCount;
-        std::array<Animation, MaxAnimations> m_animations;
+        std::shared_ptr<const AnimationSet> m_animations;
 
         friend class SpriteSystem;
         friend class SpriteSheet;
@@ -38,6 +38,7 @@ source distribution.
 #include <SFML/Graphics/RenderStates.hpp>
 
 #include <vector>
+#include <memory>
 
 namespace sf
 {
@@ -48,11 +49,20 @@ namespace xy
 {
     class Drawable;
 
+    namespace Detail
+    {
+        struct GlyphRun;
+    }
+
     /*!
     \brief ECS friendly implementation of Text.
     Text components should appear on entities which
     also have a transform and drawable component. Text
-    is drawn with a RenderSystem. NOTE As text is rendered
+    is drawn with a RenderSystem. The layout of each string
+    is shared between all Text components using the same
+    string, font, character size and outline, and when only
+    the end of a string changes only the changed characters
+    are laid out again. NOTE As text is rendered
     via a drawable component in the same way as sprites and other
     drawables, the drawable component should use setDepth() to
     increase the depth value of a text renderable so that it
@@ -206,10 +216,36 @@ namespace xy
         */
         Alignment getAlignment() const { return m_alignment; }
 
+        /*!
+        \brief Clears the layout cache shared by all Text components.
+        Cached layouts are validated against the font before they are
+        reused, so this is only needed to release memory, for example
+        when a font which was not loaded via a FontResource is destroyed.
+        FontResource calls this automatically when it is destroyed.
+        */
+        static void clearGlyphCache();
+
+        /*!
+        \brief Counters describing the work done laying out text
+        */
+        struct LayoutStats final
+        {
+            std::size_t glyphLookups = 0; //!< Number of glyphs fetched from fonts
+            std::size_t kerningLookups = 0; //!< Number of kerning values fetched from fonts
+            std::size_t cachedLayouts = 0; //!< Number of laid out strings currently in the layout cache
+        };
+
+        /*!
+        \brief Returns the layout statistics of all Text components.
+        Lookup counts are the totals since the program started, so
+        the difference between two calls gives the work done in
+        between. Useful for profiling text which changes frequently.
+        */
+        static LayoutStats getLayoutStats();
+
     private:
         
         void updateVertices(Drawable&);
-        void addQuad(std::vector<sf::Vertex>&, sf::Vector2f position, sf::Color, const sf::Glyph& glyph, float = 0.f);
 
         sf::String m_string;
         const sf::Font* m_font;
@@ -220,6 +256,7 @@ namespace xy
         float m_outlineThickness;
         bool m_dirty;
         Alignment m_alignment;
+        std::shared_ptr<const Detail::GlyphRun> m_glyphRun;
 
         friend class TextSystem;
     };
@@ -0,0 +1,247 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <vector>
+#include <unordered_map>
+
+namespace sf
+{
+    class Texture;
+}
+
+namespace xy
+{
+    /*!
+    \brief Component containing a single orthogonal tile layer.
+    The layer is divided into square chunks of tiles, each of which
+    is built into one vertex array per tileset the first time it becomes
+    visible. Requires a TileMapSystem in the scene to be drawn, and a
+    Transform component to be positioned. Layers can be populated by hand
+    or loaded from a tmx map with xy::Util::Tmx::loadTileLayer()
+    */
+    class XY_EXPORT_API TileMapLayer final
+    {
+    public:
+        /*!
+        \brief A single tile within the layer. An ID of 0 is an empty tile,
+        otherwise it is the global ID of the tile across all tilesets
+        */
+        struct Tile final
+        {
+            sf::Uint32 id = 0;
+            sf::Uint8 flipFlags = 0;
+        };
+
+        /*!
+        \brief Flags used to flip tiles when drawn. These match
+        the values used by tmx maps.
+        */
+        enum FlipFlag
+        {
+            Horizontal = 0x8,
+            Vertical = 0x4,
+            Diagonal = 0x2
+        };
+
+        /*!
+        \brief A single frame of a tile animation
+        */
+        struct Frame final
+        {
+            sf::Uint32 id = 0; //! <global ID of the tile to display
+            float duration = 0.1f; //! <in seconds
+        };
+
+        static constexpr sf::Uint32 DefaultChunkSize = 32;
+
+        TileMapLayer();
+
+        /*!
+        \brief Creates the layer with the given size.
+        \param tileCount Number of tiles along each axis
+        \param tileSize Size of a single grid cell in world units
+        \param tiles Optional vector of tileCount.x * tileCount.y tiles,
+        in row order. If this is empty the layer is created with empty tiles.
+        */
+        void create(sf::Vector2u tileCount, sf::Vector2f tileSize, std::vector<Tile> tiles = {});
+
+        /*!
+        \brief Adds a tileset which the tiles in the layer reference.
+        \param texture Texture containing the tileset image. Must remain
+        valid for the lifetime of the component.
+        \param firstID The global ID of the first tile in the set
+        \param tileCount Number of tiles in the set
+        \param columns Number of columns of tiles in the texture
+        \param tileSize Size of a single tile in the texture, in pixels
+        \param margin Distance in pixels around the edge of the texture
+        \param spacing Distance in pixels between each tile in the texture
+        */
+        void addTileset(const sf::Texture& texture, sf::Uint32 firstID, sf::Uint32 tileCount, sf::Uint32 columns,
+                        sf::Vector2u tileSize, sf::Uint32 margin = 0, sf::Uint32 spacing = 0);
+
+        /*!
+        \brief Animates the tile with the given global ID.
+        Only the texture coordinates of animated tiles are
+        updated when the animation changes frame. Frames must use
+        tiles from the same tileset as the animated tile.
+        */
+        void addAnimation(sf::Uint32 id, std::vector<Frame> frames);
+
+        /*!
+        \brief Sets the tile at the given grid position.
+        Only the chunk containing the tile is rebuilt.
+        */
+        void setTile(sf::Vector2u position, Tile tile);
+
+        /*!
+        \brief Returns the tile at the given grid position
+        */
+        Tile getTile(sf::Vector2u position) const;
+
+        /*!
+        \brief Sets the number of tiles along each side of a chunk.
+        Larger chunks mean fewer draw calls but more overdraw of
+        tiles which are off screen. Defaults to DefaultChunkSize.
+        */
+        void setChunkSize(sf::Uint32 size);
+
+        /*!
+        \brief Returns the current chunk size, in tiles
+        */
+        sf::Uint32 getChunkSize() const { return m_chunkSize; }
+
+        /*!
+        \brief Returns the number of chunks along each axis
+        */
+        sf::Vector2u getChunkCount() const { return m_chunkCount; }
+
+        /*!
+        \brief Sets an offset applied to all tiles in the layer
+        */
+        void setOffset(sf::Vector2f offset);
+
+        /*!
+        \brief Returns the current offset of the layer
+        */
+        sf::Vector2f getOffset() const { return m_offset; }
+
+        /*!
+        \brief Sets the colour with which the layer is modulated.
+        Use the alpha channel to set the opacity of the layer.
+        */
+        void setColour(sf::Color colour);
+
+        /*!
+        \brief Returns the current layer colour
+        */
+        sf::Color getColour() const { return m_colour; }
+
+        /*!
+        \brief Returns the number of tiles along each axis
+        */
+        sf::Vector2u getTileCount() const { return m_tileCount; }
+
+        /*!
+        \brief Returns the size of a grid cell in world units
+        */
+        sf::Vector2f getTileSize() const { return m_tileSize; }
+
+        /*!
+        \brief Returns the local bounds of the layer
+        */
+        sf::FloatRect getLocalBounds() const;
+
+    private:
+
+        struct Tileset final
+        {
+            const sf::Texture* texture = nullptr;
+            sf::Uint32 firstID = 0;
+            sf::Uint32 tileCount = 0;
+            sf::Uint32 columns = 1;
+            sf::Vector2u tileSize;
+            sf::Uint32 margin = 0;
+            sf::Uint32 spacing = 0;
+        };
+        std::vector<Tileset> m_tilesets; //sorted by firstID
+
+        struct Animation final
+        {
+            std::vector<Frame> frames;
+            std::size_t currentFrame = 0;
+            float currentTime = 0.f;
+        };
+        std::vector<Animation> m_animations;
+        std::unordered_map<sf::Uint32, std::size_t> m_animationLookup;
+        sf::Uint32 m_animationStamp; //incremented whenever any animation changes frame
+
+        struct AnimatedTile final
+        {
+            std::size_t array = 0;
+            std::size_t vertex = 0;
+            std::size_t animation = 0;
+            sf::Uint8 flipFlags = 0;
+        };
+
+        struct Chunk final
+        {
+            std::vector<std::size_t> tilesets; //index into m_tilesets for each vertex array
+            std::vector<std::vector<sf::Vertex>> vertices;
+            std::vector<AnimatedTile> animatedTiles;
+            sf::Uint32 animationStamp = 0;
+            bool dirty = true;
+        };
+        std::vector<Chunk> m_chunks;
+
+        sf::Vector2u m_tileCount;
+        sf::Vector2f m_tileSize;
+        std::vector<Tile> m_tiles;
+
+        sf::Uint32 m_chunkSize;
+        sf::Vector2u m_chunkCount;
+        sf::Vector2f m_maxTileSize; //largest tile of any tileset, used to pad culling
+
+        sf::Vector2f m_offset;
+        sf::Color m_colour;
+
+        void resetChunks();
+        void markAllDirty();
+
+        friend class TileMapSystem;
+    };
+}
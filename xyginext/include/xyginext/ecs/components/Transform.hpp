@@ -31,6 +31,7 @@ source distribution.
 
 #include <SFML/Graphics/Transformable.hpp>
 
+#include <atomic>
 #include <vector>
 
 namespace xy
@@ -38,7 +39,13 @@ namespace xy
     /*!
     \brief Wraps the SFML transformable class in a component
     friendly format, parentable to other transforms in a scene graph hierachy.
-    Transforms are non-copyable, but are moveable
+    Transforms are non-copyable, but are moveable.
+
+    The world transform is cached and only recalculated when this
+    transform or one of its parents has been modified. The setters
+    of sf::Transformable are hidden by this class in order to track
+    modifications, so transforms should not be modified through a
+    reference to sf::Transformable.
     */
     class XY_EXPORT_API Transform final : public sf::Transformable
     {
@@ -51,6 +58,21 @@ namespace xy
         Transform& operator = (const Transform&) = delete;
         Transform& operator = (Transform&&);
 
+        //these hide the sf::Transformable functions
+        //so that changes invalidate the world transform
+        void setPosition(float, float);
+        void setPosition(const sf::Vector2f&);
+        void setRotation(float);
+        void setScale(float, float);
+        void setScale(const sf::Vector2f&);
+        void setOrigin(float, float);
+        void setOrigin(const sf::Vector2f&);
+        void move(float, float);
+        void move(const sf::Vector2f&);
+        void rotate(float);
+        void scale(float, float);
+        void scale(const sf::Vector2f&);
+
         /*!
         \brief Adds a child transform to this one
         */
@@ -63,8 +85,11 @@ namespace xy
         void removeChild(Transform&);
 
         /*!
-        \brief Returns the world position of this transform by
-        multiplying it with any parent transforms it may have
+        \brief Returns the world transform of this transform by
+        multiplying it with any parent transforms it may have.
+        The result is cached until this transform or one of its
+        parents is modified. This is safe to call from multiple
+        threads, as long as no thread is modifying the hierarchy.
         */
         sf::Transform getWorldTransform() const;
 
@@ -93,6 +118,27 @@ namespace xy
         std::vector<Transform*> m_children;
         std::size_t m_depth;
 
+        enum WorldState : sf::Uint8
+        {
+            Dirty, Updating, Clean
+        };
+        mutable sf::Transform m_worldTransform;
+        mutable std::atomic<sf::Uint8> m_worldState;
+
+        //incremented each time the world transform is invalidated
+        std::atomic<sf::Uint32> m_version;
+
         void setDepth(std::size_t);
+        void markDirty();
+
+        //returns true if the world transform may have changed since
+        //the given version was returned, and updates the version
+        bool worldTransformChanged(sf::Uint32& version) const;
+
+        //incremented whenever any transform is reparented or destroyed
+        static sf::Uint32 getHierarchyVersion();
+
+        friend class TransformSystem;
+        friend class RenderSystem;
     };
 }
@@ -29,8 +29,13 @@ source distribution.
 
 #include "xyginext/ecs/System.hpp"
 
+#include <array>
+#include <cstdint>
+
 namespace xy
 {
+    struct Callback;
+
     /*!
     \brief Performs a given callback function on an entity.
     This is useful for behaviour code on entities which aren't used often.
@@ -43,6 +48,9 @@ namespace xy
     so this system should be reserved for specific cases where it makes sense
     or for rapid prototying of ideas that may or may not be expanded to a full
     system.
+    Callbacks put to sleep with Callback::sleepFor() or Callback::wakeAt()
+    are stored in a hierarchical timing wheel, so that sleeping entities cost
+    nothing per frame.
     */
     class XY_EXPORT_API CallbackSystem final : public System
     {
@@ -50,5 +58,48 @@ namespace xy
         explicit CallbackSystem(MessageBus&);
 
         void process(float) override;
+
+        /*!
+        \brief Returns the time in seconds accumulated by this system
+        since it was created. Use this as the base time when calling
+        Callback::wakeAt()
+        */
+        float getTime() const;
+
+        /*!
+        \brief Wakes the given entity's Callback if it is sleeping
+        */
+        void wake(Entity);
+
+    private:
+
+        struct SleepEntry final
+        {
+            Entity entity;
+            std::uint64_t wakeTick = 0;
+            sf::Uint32 stamp = 0;
+        };
+
+        static constexpr std::size_t WheelBits = 6;
+        static constexpr std::size_t WheelSize = 1 << WheelBits;
+        static constexpr std::size_t WheelLevels = 4;
+        std::array<std::array<std::vector<SleepEntry>, WheelSize>, WheelLevels> m_wheel;
+        std::vector<SleepEntry> m_expiredEntries;
+
+        std::uint64_t m_currentTick;
+        float m_tickAccumulator;
+
+        std::vector<Entity> m_awakeEntities;
+        std::vector<std::size_t> m_awakeIndices; //position in m_awakeEntities, by entity index
+        std::vector<sf::Uint32> m_sleepStamps; //invalidates wheel entries when an entity wakes or is removed, by entity index
+
+        void sleep(Entity, Callback&);
+        void addAwake(Entity);
+        void removeAwake(Entity);
+        void insert(const SleepEntry&);
+        void advance();
+
+        void onEntityAdded(Entity) override;
+        void onEntityRemoved(Entity) override;
     };
 }
@@ -29,6 +29,7 @@ source distribution.
 
 #include "xyginext/ecs/System.hpp"
 
+#include <array>
 #include <functional>
 
 namespace xy
@@ -46,7 +47,13 @@ namespace xy
 
     /*
     \brief The command system is used to execute commands which are
-    targetted at specific IDs
+    targetted at specific IDs.
+    Entities are sorted into a bucket for each bit set in their
+    CommandTarget ID, so that each command only visits the entities
+    whose IDs share at least one bit with the command's targetFlags.
+    Changes made with CommandTarget::setID() are applied before the
+    next command is executed, so a command which changes an entity's
+    ID affects which later commands in the same frame visit it.
     */
     class XY_EXPORT_API CommandSystem final : public xy::System
     {
@@ -56,8 +63,10 @@ namespace xy
         /*!
         \brief Places a command on the command queue.
         Each frame the entire queue is processed and cleared,
-        executing each command on each entity with a matching
-        CommandTarget flag.
+        executing each command once on each entity with a matching
+        CommandTarget flag. The queue grows as needed, so commands
+        are never dropped. Commands sent while the queue is being
+        processed are executed the following frame.
         \see CommandTarget
         */
         void sendCommand(const Command&);
@@ -70,6 +79,26 @@ namespace xy
     private:
         std::vector<Command> m_commands;
         std::vector<Command> m_commandBuffer;
-        std::size_t m_count;
+
+        struct Bucket final
+        {
+            std::vector<Entity> entities;
+            std::vector<std::size_t> positions; //position in entities, by entity index
+        };
+        std::array<Bucket, 32u> m_buckets;
+        std::vector<sf::Uint32> m_targetIDs; //ID each entity is currently bucketed with, by entity index
+        std::vector<std::size_t> m_visited; //the last command to visit each entity, by entity index
+        std::vector<Entity> m_dirtyTargets; //entities whose ID was changed with CommandTarget::setID()
+        std::size_t m_commandIndex;
+
+        void markDirty(Entity);
+        void updateBuckets();
+        void addToBuckets(Entity, sf::Uint32);
+        void removeFromBuckets(Entity, sf::Uint32);
+
+        void onEntityAdded(Entity) override;
+        void onEntityRemoved(Entity) override;
+
+        friend struct CommandTarget;
     };
 }
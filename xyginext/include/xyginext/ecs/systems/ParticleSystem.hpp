@@ -68,6 +68,8 @@ namespace xy
         void onEntityAdded(xy::Entity) override;
         void onEntityRemoved(xy::Entity) override;
 
+        void updateEmitter(ParticleEmitter&, std::size_t, float);
+
         mutable sf::Shader m_shader;
 
         struct EmitterArray
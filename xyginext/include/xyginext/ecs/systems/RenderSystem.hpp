@@ -28,17 +28,50 @@ source distribution.
 #pragma once
 
 #include "xyginext/ecs/System.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
+#include "xyginext/util/DynamicTree.hpp"
 
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/BlendMode.hpp>
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace sf
+{
+    class View;
+}
 
 namespace xy
 {
+    class Drawable;
+    class Transform;
+    class Material;
+
     /*!
     \brief Used to draw all entities which have a Drawable and Transform component.
     The RenderSystem is used to depth sort and draw all entities which have a 
     Drawable and Transform component attached, and optionally a Sprite component.
     NOTE multiple components which rely on a Drawable component cannot exist on the same entity,
     as only one set of vertices will be available.
+    Each frame the system builds a 64 bit sort key for every drawable from its depth,
+    shader, texture and blend mode, and radix sorts the entities by these keys if they
+    are out of order. Drawables with the same depth are therefore grouped by state,
+    which helps batching, and are otherwise kept in a consistent order between frames.
+    Consecutive drawables (in depth order) which share the same texture, shader,
+    blend mode and primitive type, and which are not cropped, are batched into a
+    single draw call by transforming their vertices on the CPU. Drawables which
+    use strip or fan primitive types, or which have uniforms bound to their shader,
+    are always drawn individually.
+    Optionally drawables can be stored in a DynamicTree so that culling only visits
+    those near the active view. See setBroadphaseCulling().
+    Drawables marked as static with Drawable::setStatic() are merged into vertex
+    buffers which are only updated when one of their drawables changes.
     */
     class XY_EXPORT_API RenderSystem final : public xy::System, public sf::Drawable 
     {
@@ -59,11 +92,151 @@ namespace xy
         */
         void setCullingBorder(float size);
 
+        /*!
+        \brief Enables or disables broadphase culling.
+        When enabled the world bounds of each drawable are stored in a DynamicTree,
+        which is only updated when a drawable's Transform or local bounds change.
+        Drawing then queries the tree for the drawables intersecting the active view,
+        rather than testing every drawable, which is much faster when most drawables
+        are off screen, for example in large scrolling maps. The result of each query
+        is reused if the system is drawn again with the same view before the next
+        update, such as when drawing the same scene twice for split screen.
+        The tree is updated when the system is processed, so Transforms should not be
+        modified by systems which are processed after the RenderSystem. Disabled
+        by default.
+        */
+        void setBroadphaseCulling(bool enabled);
+
+        /*!
+        \brief Returns true if broadphase culling is enabled
+        */
+        bool getBroadphaseCulling() const { return m_broadphaseCulling; }
+
+        /*!
+        \brief Returns the statistics gathered the last time this system was drawn,
+        or prepared with prepareBatches().
+        Statistics from drawing are also added to the frame totals available via RenderStats.
+        */
+        const RenderStats& getStats() const { return m_stats; }
+
+        /*!
+        \brief Culls and batches the drawables visible in the given view without drawing them.
+        This is done automatically when the system is drawn, but can be used to update
+        the statistics returned by getStats() without a render target, for example when
+        testing how drawables are batched.
+        \returns The statistics for the batches which would be drawn with the view
+        */
+        const RenderStats& prepareBatches(const sf::View&) const;
+
     private:
-        bool m_wantsSorting;
         sf::Vector2f m_cullingBorder;
 
+        //sort keys are ordered by depth, then shader, texture and blend mode
+        struct RenderItem final
+        {
+            std::uint64_t key = 0;
+            xy::Entity entity;
+        };
+        std::vector<RenderItem> m_renderQueue;
+        std::vector<RenderItem> m_sortBuffer;
+
+        void sortRenderQueue();
+
+        //static drawables are merged by state and by the grid cell which contains their centre
+        struct StaticKey final
+        {
+            sf::Int32 depth = 0;
+            const sf::Texture* texture = nullptr;
+            const sf::Shader* shader = nullptr;
+            const xy::Material* material = nullptr;
+            sf::BlendMode blendMode;
+            sf::PrimitiveType primitiveType = sf::Quads;
+            bool cull = true;
+            sf::Vector2i cell;
+
+            bool operator == (const StaticKey&) const;
+            std::uint64_t hash() const;
+        };
+
+        struct StaticChunk final
+        {
+            StaticKey key;
+            std::vector<xy::Entity> entities;
+            std::vector<sf::Vertex> vertices; //world space
+            sf::FloatRect bounds;
+            bool dirty = false;
+            mutable bool uploaded = false;
+            mutable sf::VertexBuffer buffer;
+            mutable std::size_t drawStamp = 0;
+        };
+        //chunks are never destroyed so that their vertex buffers are only
+        //ever deleted on the thread which draws them
+        std::vector<std::unique_ptr<StaticChunk>> m_staticChunks;
+        std::vector<std::size_t> m_freeStaticChunks;
+        std::unordered_multimap<std::uint64_t, std::size_t> m_staticChunkLookup;
+
+        struct StaticData final
+        {
+            std::int32_t chunk = -1;
+            StaticKey key;
+            sf::Uint32 transformVersion = 0;
+            sf::Uint32 vertexVersion = 0;
+        };
+        std::vector<StaticData> m_staticData; //indexed by entity index
+        mutable std::size_t m_drawStamp;
+
+        void updateStaticGeometry(xy::Entity, const xy::Drawable&, const xy::Transform&);
+        void addToStaticChunk(xy::Entity, const StaticKey&);
+        void removeFromStaticChunk(xy::Entity);
+        void rebuildStaticChunks();
+
+        struct Batch final
+        {
+            const xy::Drawable* drawable = nullptr; //first drawable, whose states are used to draw the batch
+            sf::Transform transform; //only used by batches of one, which are drawn with their own vertices
+            std::size_t vertexStart = 0;
+            std::size_t vertexCount = 0;
+            std::size_t drawableCount = 0;
+            bool batchable = false;
+            const StaticChunk* chunk = nullptr; //static geometry is drawn from the chunk's vertices
+        };
+        mutable std::vector<Batch> m_batches;
+        mutable std::vector<sf::Vertex> m_batchVertices; //world space vertices of batches with more than one drawable
+        mutable RenderStats m_stats;
+
+        void buildBatches(sf::FloatRect viewableArea) const;
+
+        bool m_broadphaseCulling;
+        DynamicTree m_tree;
+
+        struct CullData final
+        {
+            std::int32_t proxyID = DynamicTree::NullNode;
+            sf::Uint32 transformVersion = 0;
+            sf::Uint32 boundsVersion = 0;
+            sf::FloatRect worldBounds;
+        };
+        std::vector<CullData> m_cullData; //indexed by entity index
+        std::vector<std::uint32_t> m_unculledEntities; //indices of entities which are always drawn
+
+        mutable std::vector<std::size_t> m_renderOrder; //entity index to position in entity list
+        mutable bool m_renderOrderDirty;
+
+        struct CullResult final
+        {
+            sf::FloatRect area;
+            std::vector<std::size_t> visible; //positions in entity list, in draw order
+        };
+        mutable std::vector<CullResult> m_cullResults;
+        mutable std::size_t m_cullResultCount;
+        mutable std::vector<std::uint32_t> m_queryResults;
+
+        void updateBroadphase(xy::Entity, const xy::Drawable&, const xy::Transform&);
+        const std::vector<std::size_t>& getVisibleEntities(sf::FloatRect area) const;
+
         void onEntityAdded(xy::Entity) override;
+        void onEntityRemoved(xy::Entity) override;
+
         void draw(sf::RenderTarget&, sf::RenderStates) const override;
     };
 }
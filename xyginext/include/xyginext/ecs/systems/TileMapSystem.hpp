@@ -0,0 +1,63 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/ecs/System.hpp"
+#include "xyginext/ecs/components/TileMapLayer.hpp"
+
+#include <SFML/Graphics/Drawable.hpp>
+
+namespace xy
+{
+    /*!
+    \brief Updates and draws entities with a TileMapLayer component.
+    Tile animations are advanced in process(), while chunks are built
+    and animated texture coordinates refreshed only when a chunk is
+    visible during draw(). The visible chunks are found directly from
+    the view rectangle so the per-frame cost depends on the size of the
+    view, not the size of the map. Layers are drawn in the order in which
+    they were added to the scene, and the system is drawn as a whole in
+    the order in which it was added to the scene relative to other
+    drawable systems.
+    */
+    class XY_EXPORT_API TileMapSystem final : public xy::System, public sf::Drawable
+    {
+    public:
+        explicit TileMapSystem(xy::MessageBus&);
+
+        void process(float) override;
+
+    private:
+
+        void buildChunk(TileMapLayer&, std::size_t) const;
+        void updateAnimatedTiles(TileMapLayer&, TileMapLayer::Chunk&) const;
+
+        void draw(sf::RenderTarget&, sf::RenderStates) const override;
+    };
+}
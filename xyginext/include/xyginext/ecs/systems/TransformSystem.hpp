@@ -0,0 +1,89 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/ecs/System.hpp"
+
+#include <SFML/Config.hpp>
+
+#include <vector>
+
+namespace xy
+{
+    class Transform;
+
+    /*!
+    \brief Optional system which updates the cached world transform of
+    every Transform in the scene in a single batched pass.
+    Transforms are stored in flat arrays ordered by their depth in the scene
+    graph, so that parents are always updated before their children. Only
+    transforms which have been modified since they were last updated are
+    recalculated. The arrays are only rebuilt when entities are added or
+    removed, or when the scene graph hierarchy changes.
+
+    Without this system world transforms are calculated lazily, on demand,
+    by Transform::getWorldTransform(). Scenes with large numbers of parented
+    transforms, such as UI or crowds of sprites, may benefit from adding this
+    system before any systems which read world transforms, such as the
+    RenderSystem.
+    */
+    class XY_EXPORT_API TransformSystem final : public System
+    {
+    public:
+        explicit TransformSystem(MessageBus&);
+
+        void process(float) override;
+
+    private:
+        static constexpr sf::Uint32 NoParent = 0xffffffff;
+
+        std::vector<Transform*> m_transforms; //sorted by depth
+        std::vector<sf::Uint32> m_parents; //index into m_transforms
+        std::vector<sf::Uint8> m_updated; //set if the world matrix was updated this frame
+        std::vector<sf::Uint32> m_dirtyIndices; //transforms to update this frame, sorted by depth
+
+        //local affine matrices of dirty transforms
+        std::vector<float> m_l00, m_l01, m_l02;
+        std::vector<float> m_l10, m_l11, m_l12;
+
+        //affine world matrices, indexed the same as m_transforms
+        std::vector<float> m_w00, m_w01, m_w02;
+        std::vector<float> m_w10, m_w11, m_w12;
+
+        sf::Uint32 m_hierarchyVersion;
+        bool m_rebuild;
+
+        void rebuild();
+        void calcLocalTransforms(std::size_t, std::size_t);
+        void calcWorldTransforms();
+
+        void onEntityAdded(Entity) override;
+        void onEntityRemoved(Entity) override;
+    };
+}
@@ -0,0 +1,102 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace xy
+{
+    /*!
+    \brief A set of sprite animations.
+    Animation sets are created once, usually when a SpriteSheet is
+    loaded, and shared between all Sprite components created from the
+    same sprite via a std::shared_ptr<const AnimationSet>, so that
+    copying a Sprite does not copy its animation data. To modify the
+    animations of a single sprite copy its set, modify the copy and
+    assign it to the sprite with Sprite::setAnimationSet().
+    */
+    class XY_EXPORT_API AnimationSet final
+    {
+    public:
+        /*!
+        \brief Represents a single animation
+        */
+        struct Animation final
+        {
+            std::string id;
+            std::vector<sf::FloatRect> frames;
+            std::uint32_t loopStart = 0; //!< looped animations can jump to somewhere other than the beginning
+            bool looped = false;
+            float framerate = 12.f;
+        };
+
+        /*!
+        \brief Adds an animation to the set
+        \returns The index of the new animation
+        */
+        std::size_t addAnimation(const Animation&);
+
+        /*!
+        \brief Returns the number of animations in the set
+        */
+        std::size_t getAnimationCount() const { return m_animations.size(); }
+
+        /*!
+        \brief Returns the animation at the given index
+        */
+        const Animation& getAnimation(std::size_t index) const;
+
+        /*!
+        \brief Returns a mutable reference to the animation at the
+        given index. Only use this on sets which are not yet shared
+        with any Sprite components.
+        */
+        Animation& getAnimation(std::size_t index);
+
+        /*!
+        \brief Returns all the animations in the set
+        */
+        const std::vector<Animation>& getAnimations() const { return m_animations; }
+
+        /*!
+        \brief Returns the index of the animation with the given id
+        if it exists, else returns 0
+        */
+        std::size_t getAnimationIndex(const std::string& id) const;
+
+    private:
+        std::vector<Animation> m_animations;
+    };
+}
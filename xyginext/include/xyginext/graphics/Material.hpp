@@ -0,0 +1,143 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Vector3.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sf
+{
+    class Shader;
+    class Texture;
+}
+
+namespace xy
+{
+    /*!
+    \brief A shader along with a set of uniform values, which can be
+    shared between any number of Drawable components.
+    Uniform locations are looked up once, the first time the material
+    is applied, after which values are set directly by location. Shader
+    programs keep their uniform values, so only values which have changed
+    are uploaded, unless another material has been applied to the same
+    shader in the meantime. The
+    RenderSystem only applies a material when it differs from the one
+    used by the previous drawable, and drawables which share a material
+    (and have no uniforms bound to them individually) can be batched.
+    Materials must outlive any Drawable which uses them.
+    \see Drawable::setMaterial()
+    */
+    class XY_EXPORT_API Material final
+    {
+    public:
+        Material();
+        explicit Material(sf::Shader& shader);
+
+        /*!
+        \brief Sets the shader used by this material.
+        Any uniform values already set are kept, and applied to the
+        new shader.
+        */
+        void setShader(sf::Shader* shader);
+
+        /*!
+        \brief Returns a pointer to the shader used by this material, if any
+        */
+        sf::Shader* getShader() const { return m_shader; }
+
+        /*!
+        \brief Sets the value of the given uniform.
+        If the uniform has already been set its value is updated.
+        */
+        void setUniform(const std::string& name, float value);
+        void setUniform(const std::string& name, sf::Vector2f value);
+        void setUniform(const std::string& name, sf::Vector3f value);
+        void setUniform(const std::string& name, bool value);
+        void setUniform(const std::string& name, sf::Color colour);
+        void setUniform(const std::string& name, const sf::Texture& texture);
+
+        /*!
+        \brief Sets the given uniform to a pointer to a float array
+        containing a 4x4 matrix. The matrix is read each time the
+        material is applied, so must outlive the material.
+        */
+        void setUniform(const std::string& name, const float* matrix);
+
+        /*!
+        \brief Sets the given uniform to the value of sf::Shader::CurrentTexture
+        */
+        void setUniformToCurrentTexture(const std::string& name);
+
+        /*!
+        \brief Returns true if no uniform values have been set
+        */
+        bool empty() const { return m_uniforms.empty(); }
+
+        /*!
+        \brief Uploads the uniform values to the shader.
+        Generally not used unless implementing a custom render system,
+        in which case this should be called before drawing with the shader.
+        The shader's program must be bound, for example with sf::Shader::bind(),
+        when this is called.
+        */
+        void apply() const;
+
+    private:
+        enum class UniformType : std::uint8_t
+        {
+            Float, Vec2, Vec3, Bool, Colour, Matrix, Texture, CurrentTexture
+        };
+
+        static constexpr std::int32_t Unresolved = -2;
+
+        struct Uniform final
+        {
+            std::string name;
+            mutable std::int32_t location = Unresolved;
+            UniformType type = UniformType::Float;
+            std::array<float, 4> values = {};
+            const void* pointer = nullptr; //texture or matrix
+            mutable bool dirty = true;
+        };
+
+        sf::Shader* m_shader;
+        std::vector<Uniform> m_uniforms;
+        mutable std::uint64_t m_applyStamp; //matches the shader's stamp if no other material has been applied since
+
+        Uniform& getUniform(const std::string& name, UniformType type);
+    };
+}
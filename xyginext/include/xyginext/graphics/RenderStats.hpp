@@ -0,0 +1,104 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace xy
+{
+    /*!
+    \brief Counters describing the cost of rendering.
+    The built in RenderSystem, ParticleSystem and Scene post process
+    chain add their counts to the current frame each time they are
+    drawn. At the end of each frame the totals are stored, and are
+    displayed in the Stats tab of the Console along with a graph of
+    recent frames. Custom renderers may add their own counts with
+    addToFrame().
+
+    These functions are not threadsafe, and are expected to be used
+    only from the thread which does the rendering.
+    */
+    class XY_EXPORT_API RenderStats final
+    {
+    public:
+        std::size_t drawCalls = 0; //!< Number of draw calls made
+        std::size_t vertexCount = 0; //!< Number of vertices submitted
+        std::size_t drawablesDrawn = 0; //!< Number of drawables which passed culling
+        std::size_t drawablesCulled = 0; //!< Number of drawables which were culled
+        std::size_t batchedDrawables = 0; //!< Number of drawables drawn as part of a batch of more than one
+        std::size_t textureChanges = 0; //!< Number of times the texture changed between draw calls
+        std::size_t shaderChanges = 0; //!< Number of times the shader changed between draw calls
+        std::size_t blendModeChanges = 0; //!< Number of times the blend mode changed between draw calls
+        std::size_t scissorChanges = 0; //!< Number of times the scissor rectangle was set
+        std::size_t renderTargetChanges = 0; //!< Number of times rendering switched to a different render texture
+
+        RenderStats& operator += (const RenderStats&);
+
+        /*!
+        \brief Number of frames stored in the history
+        */
+        static constexpr std::size_t HistorySize = 120;
+
+        /*!
+        \brief Adds the given counts to the totals of the current frame
+        */
+        static void addToFrame(const RenderStats&);
+
+        /*!
+        \brief Returns the totals of the most recently completed frame
+        */
+        static const RenderStats& getLastFrame();
+
+        /*!
+        \brief Returns the totals of the last HistorySize frames.
+        The array is used as a ring buffer, the oldest frame of which
+        is at the index returned by getHistoryOffset()
+        */
+        static const std::array<RenderStats, HistorySize>& getHistory();
+
+        /*!
+        \brief Returns the index of the oldest frame in the history
+        */
+        static std::size_t getHistoryOffset();
+
+        /*
+        \brief Used by xygine to store the totals at the end of each frame.
+        This should not be called by the user.
+        */
+        static void endFrame();
+
+    private:
+        static RenderStats m_currentFrame;
+        static std::array<RenderStats, HistorySize> m_history;
+        static std::size_t m_historyIndex;
+    };
+}
@@ -65,7 +65,8 @@ namespace xy
         /*!
         \brief Returns a sprite component with the given name as it
         appears in the sprite sheet. If the sprite does not exist an
-        empty sprite is returned.
+        empty sprite is returned. The returned sprite shares its
+        AnimationSet with the sprite sheet, so is cheap to copy.
         */
         Sprite getSprite(const std::string& name) const;
         
@@ -107,11 +108,13 @@ namespace xy
 
     private:
         mutable std::unordered_map<std::string, Sprite> m_sprites;
-        mutable std::unordered_map<std::string, std::vector<std::string>> m_animations;
 
         std::string m_texturePath;
         bool m_smooth;
 
         bool loadFromFile(const std::string& path, std::function<sf::Texture*(const std::string&)>&);
+
+        friend class TextureAtlas;
+        void setAtlasTexture(const sf::Texture&, sf::Vector2f offset);
     };
 }
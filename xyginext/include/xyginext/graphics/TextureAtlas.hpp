@@ -0,0 +1,155 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace xy
+{
+    class SpriteSheet;
+
+    /*!
+    \brief Packs the textures of multiple sprite sheets into one or more
+    large texture pages at load time.
+    Sprites drawn from the same page can be batched by the RenderSystem,
+    whereas sprites from different sprite sheets otherwise always use
+    different textures. Add the sprite sheets to be packed once they are
+    loaded, then call build() to pack the sheet textures and rewrite the
+    texture rectangles and animation frames of each sheet to point into
+    the atlas. This should be done before any sprites are retrieved from
+    the sprite sheets, and the atlas must outlive any sprites using it.
+    Sheets which have been added to an atlas should not be saved with
+    SpriteSheet::saveToFile() as their coordinates are relative to the atlas.
+
+    Packing results can be saved with saveToFile() and loaded with
+    loadFromFile() on subsequent runs, in which case build() uses the
+    loaded placement as long as the source images are the same size.
+    EG:
+    \code
+    xy::TextureAtlas atlas;
+    atlas.addSpriteSheet(playerSheet);
+    atlas.addSpriteSheet(enemySheet);
+
+    const std::string cachePath = xy::FileSystem::getConfigDirectory("my_game") + "sprites.atlas";
+    atlas.loadFromFile(cachePath);
+    if (atlas.build())
+    {
+        atlas.saveToFile(cachePath);
+    }
+    \endcode
+    */
+    class XY_EXPORT_API TextureAtlas final
+    {
+    public:
+        TextureAtlas();
+
+        /*!
+        \brief Sets the maximum size of each texture page.
+        Defaults to 2048x2048. Changing this invalidates any loaded placement.
+        Sizes are clamped to 65535, and to the largest texture supported by
+        the graphics driver.
+        */
+        void setPageSize(sf::Vector2u size);
+
+        /*!
+        \brief Sets the number of pixels left between each packed image.
+        Defaults to 2. Changing this invalidates any loaded placement.
+        */
+        void setPadding(sf::Uint32 padding);
+
+        /*!
+        \brief Sets whether or not the texture pages are smoothed.
+        Defaults to false
+        */
+        void setSmooth(bool smooth);
+
+        /*!
+        \brief Adds a loaded sprite sheet to be packed by build()
+        */
+        void addSpriteSheet(SpriteSheet& sheet);
+
+        /*!
+        \brief Packs the textures of all the added sprite sheets into
+        texture pages, and updates the sheets to use them.
+        Images which are too large to fit on a page are left in their
+        own texture. The sprite sheets are removed from the atlas once
+        built, so that their coordinates are only moved once.
+        \returns true if at least one sprite sheet was moved to the atlas
+        */
+        bool build();
+
+        /*!
+        \brief Returns the number of texture pages created by build()
+        */
+        std::size_t getPageCount() const { return m_pages.size(); }
+
+        /*!
+        \brief Returns the texture page at the given index
+        */
+        const sf::Texture& getPage(std::size_t index) const;
+
+        /*!
+        \brief Loads an atlas description previously saved with saveToFile().
+        The path is used as is, and is not relative to the resource directory.
+        \returns true if successful, else false
+        */
+        bool loadFromFile(const std::string& path);
+
+        /*!
+        \brief Saves the placement of each image packed by build() so that
+        packing can be skipped the next time the same images are loaded.
+        The path is used as is, and is not relative to the resource directory.
+        \returns true if successful, else false
+        */
+        bool saveToFile(const std::string& path) const;
+
+    private:
+        struct Placement final
+        {
+            std::size_t page = 0;
+            sf::IntRect bounds;
+        };
+        std::unordered_map<std::string, Placement> m_placements;
+
+        sf::Vector2u m_pageSize;
+        sf::Uint32 m_padding;
+        bool m_smooth;
+
+        std::vector<SpriteSheet*> m_spriteSheets;
+        std::vector<std::unique_ptr<sf::Texture>> m_pages;
+    };
+}
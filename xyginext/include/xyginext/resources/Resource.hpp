@@ -155,6 +155,7 @@ namespace xy
     {
     public:
         FontResource();
+        ~FontResource();
     private:
         sf::Font m_font;
         std::unique_ptr<sf::Font> errorHandle() override;
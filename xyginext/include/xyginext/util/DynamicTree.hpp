@@ -0,0 +1,153 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/Config.hpp"
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace xy
+{
+    /*!
+    \brief A dynamic AABB tree used for broadphase queries.
+    Each proxy is stored with a 'fat' bounding box, enlarged by a margin, so
+    that small movements do not require the tree to be updated. The tree is
+    balanced with rotations as proxies are inserted and removed, so queries
+    only visit the parts of the tree which overlap the query area.
+    Proxies are referenced by the ID returned from addProxy(), and carry an
+    arbitrary 32 bit value (such as an entity index) which is returned by
+    queries. This is the tree used by the DynamicTreeSystem and by the
+    broadphase culling of the RenderSystem.
+    */
+    class XY_EXPORT_API DynamicTree final
+    {
+    public:
+        static constexpr std::int32_t NullNode = -1;
+
+        /*!
+        \brief Constructor
+        \param margin Amount by which the bounds of each proxy are enlarged
+        */
+        explicit DynamicTree(float margin = 16.f);
+
+        /*!
+        \brief Adds a proxy with the given bounds and user data
+        \returns ID of the proxy
+        */
+        std::int32_t addProxy(sf::FloatRect bounds, std::uint32_t userData);
+
+        /*!
+        \brief Removes the proxy with the given ID
+        */
+        void removeProxy(std::int32_t proxyID);
+
+        /*!
+        \brief Updates the bounds of a proxy.
+        The tree is only modified if the new bounds are no longer
+        contained by the proxy's fat bounds.
+        \param proxyID ID of the proxy to update
+        \param bounds New bounds of the proxy
+        \param displacement Optional distance the proxy moved since it
+        was last updated. When the proxy is reinserted its fat bounds are
+        extended in the direction of movement, by twice this amount, so
+        that proxies which keep moving the same way are reinserted less often.
+        \returns true if the proxy was reinserted
+        */
+        bool moveProxy(std::int32_t proxyID, sf::FloatRect bounds, sf::Vector2f displacement = {});
+
+        /*!
+        \brief Returns the fat bounds of the given proxy
+        */
+        sf::FloatRect getFatBounds(std::int32_t proxyID) const;
+
+        /*!
+        \brief Returns the user data of the given proxy
+        */
+        std::uint32_t getUserData(std::int32_t proxyID) const;
+
+        /*!
+        \brief Appends the user data of every proxy whose fat bounds
+        intersect the given area to the results vector.
+        */
+        void query(sf::FloatRect area, std::vector<std::uint32_t>& results) const;
+
+        /*!
+        \brief Removes all proxies from the tree
+        */
+        void clear();
+
+        /*!
+        \brief Returns the height of the tree
+        */
+        std::int32_t getHeight() const;
+
+        /*!
+        \brief Returns the number of proxies in the tree
+        */
+        std::size_t getProxyCount() const { return m_proxyCount; }
+
+    private:
+        struct Bounds final
+        {
+            float left = 0.f;
+            float top = 0.f;
+            float right = 0.f;
+            float bottom = 0.f;
+        };
+
+        struct Node final
+        {
+            Bounds bounds;
+            std::int32_t parent = NullNode; //doubles as the next free node
+            std::int32_t child1 = NullNode;
+            std::int32_t child2 = NullNode;
+            std::int32_t height = -1; //leaves are 0, free nodes -1
+            std::uint32_t userData = 0;
+
+            bool isLeaf() const { return child1 == NullNode; }
+        };
+
+        float m_margin;
+        std::int32_t m_root;
+        std::vector<Node> m_nodes;
+        std::int32_t m_freeList;
+        std::size_t m_proxyCount;
+
+        std::int32_t allocateNode();
+        void freeNode(std::int32_t);
+
+        void insertLeaf(std::int32_t);
+        void removeLeaf(std::int32_t);
+
+        std::int32_t balance(std::int32_t);
+    };
+}
@@ -0,0 +1,135 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include "xyginext/core/Log.hpp"
+#include "xyginext/ecs/components/TileMapLayer.hpp"
+#include "xyginext/resources/Resource.hpp"
+
+#include <tmxlite/Map.hpp>
+#include <tmxlite/TileLayer.hpp>
+
+#include <algorithm>
+
+namespace xy
+{
+    namespace Util
+    {
+        /*!
+        \brief Helpers for loading tmx maps with tmxlite. These functions
+        are header only and use only the inline parts of the tmxlite API,
+        so xyginext itself does not link against tmxlite. Projects which
+        include this file need the tmxlite headers in their include path
+        and should link tmxlite to load the tmx::Map.
+        */
+        namespace Tmx
+        {
+            /*!
+            \brief Loads the tile layer at the given index of a map into a TileMapLayer.
+            \param map A tmx::Map which has successfully loaded a map file
+            \param layerIndex Index of the layer to load, as returned by tmx::Map::getLayers()
+            \param layer TileMapLayer component to populate
+            \param textures TextureResource used to load the tileset images
+            \returns true on success, else false if the map is not orthogonal
+            or the layer does not exist or is not a tile layer.
+            */
+            inline bool loadTileLayer(const tmx::Map& map, std::size_t layerIndex, TileMapLayer& layer, TextureResource& textures)
+            {
+                if (map.getOrientation() != tmx::Orientation::Orthogonal)
+                {
+                    Logger::log("Only orthogonal tmx maps are supported", Logger::Type::Error);
+                    return false;
+                }
+
+                const auto& layers = map.getLayers();
+                if (layerIndex >= layers.size()
+                    || layers[layerIndex]->getType() != tmx::Layer::Type::Tile)
+                {
+                    Logger::log("Layer " + std::to_string(layerIndex) + " is not a tile layer", Logger::Type::Error);
+                    return false;
+                }
+
+                //avoid dynamic_cast so no tmxlite type info is needed at link time
+                const auto& tileLayer = static_cast<const tmx::TileLayer&>(*layers[layerIndex]);
+                const auto& tmxTiles = tileLayer.getTiles();
+
+                const auto tileCount = map.getTileCount();
+                const auto tileSize = map.getTileSize();
+                if (tmxTiles.size() != tileCount.x * tileCount.y)
+                {
+                    Logger::log(tileLayer.getName() + ": unexpected tile count", Logger::Type::Error);
+                    return false;
+                }
+
+                std::vector<TileMapLayer::Tile> tiles(tmxTiles.size());
+                for (auto i = 0u; i < tmxTiles.size(); ++i)
+                {
+                    tiles[i].id = tmxTiles[i].ID;
+                    tiles[i].flipFlags = tmxTiles[i].flipFlags;
+                }
+
+                layer = TileMapLayer();
+                layer.create({ tileCount.x, tileCount.y },
+                    { static_cast<float>(tileSize.x), static_cast<float>(tileSize.y) }, std::move(tiles));
+
+                for (const auto& tileset : map.getTilesets())
+                {
+                    const auto& texture = textures.get(tileset.getImagePath());
+                    const auto tsTileSize = tileset.getTileSize();
+                    layer.addTileset(texture, tileset.getFirstGID(), tileset.getTileCount(),
+                        std::max(std::uint32_t(1), tileset.getColumnCount()), { tsTileSize.x, tsTileSize.y },
+                        tileset.getMargin(), tileset.getSpacing());
+
+                    //tile IDs are local to the tileset, frame IDs are global
+                    for (const auto& tile : tileset.getTiles())
+                    {
+                        if (!tile.animation.frames.empty())
+                        {
+                            std::vector<TileMapLayer::Frame> frames;
+                            for (const auto& frame : tile.animation.frames)
+                            {
+                                frames.push_back({ frame.tileID, static_cast<float>(frame.duration) / 1000.f });
+                            }
+                            layer.addAnimation(tileset.getFirstGID() + tile.ID, std::move(frames));
+                        }
+                    }
+                }
+
+                const auto offset = tileLayer.getOffset();
+                layer.setOffset({ static_cast<float>(offset.x), static_cast<float>(offset.y) });
+
+                sf::Color colour = sf::Color::White;
+                colour.a = static_cast<sf::Uint8>(tileLayer.getOpacity() * 255.f);
+                layer.setColour(colour);
+
+                return true;
+            }
+        }
+    }
+}
@@ -32,6 +32,7 @@ source distribution.
 #include "xyginext/core/FileSystem.hpp"
 #include "xyginext/detail/Operators.hpp"
 #include "xyginext/gui/GuiClient.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
 
 #include "../imgui/imgui.h"
 #include "../imgui/imgui-SFML.h"
@@ -150,7 +151,7 @@ void App::run()
             handleMessages();
 
             update(timePerFrame);
-            
+            m_messageRecorder.endFrame(timePerFrame);
         }
         
         ImGui::SFML::Update(m_renderWindow, sf::seconds(elapsedTime));
@@ -165,12 +166,14 @@ void App::run()
             glCheck(glClearColor(clearColour.r / 255.f, clearColour.g / 255.f, clearColour.b / 255.f, clearColour.a / 255.f));
             glCheck(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
         }
-        draw();       
+        draw();
+        RenderStats::endFrame();
         ImGui::SFML::Render(m_renderWindow);
         m_renderWindow.display();
     }
 
     m_messageBus.disable(); //prevents spamming with loads of entity quit messages
+    m_messageRecorder.close();
     
     finalise();
     Console::finalise();  
@@ -340,6 +343,25 @@ bool App::isMouseCursorVisible()
     return m_mouseCursorVisible || Console::isVisible();
 }
 
+bool App::startRecording(const std::string& path)
+{
+    if (m_messageRecorder.open(path))
+    {
+        Console::print("Recording messages to " + path);
+        return true;
+    }
+    return false;
+}
+
+void App::stopRecording()
+{
+    if (m_messageRecorder.isOpen())
+    {
+        Console::print("Recorded " + std::to_string(m_messageRecorder.getFrameCount()) + " frames");
+        m_messageRecorder.close();
+    }
+}
+
 //protected
 bool App::initialise() { return true; }
 
@@ -430,6 +452,7 @@ void App::handleEvents()
         default: break;
         }
         
+        m_messageRecorder.recordEvent(evt);
         eventHandler(evt);
     }   
 }
@@ -440,6 +463,7 @@ void App::handleMessages()
     {
         auto msg = m_messageBus.poll();
 
+        m_messageRecorder.recordMessage(msg);
         handleMessage(msg);
     } 
 }
@@ -33,6 +33,7 @@ source distribution.
 #include "xyginext/core/Assert.hpp"
 #include "xyginext/audio/Mixer.hpp"
 #include "xyginext/gui/GuiClient.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
 
 #include "../imgui/imgui.h"
 
@@ -416,6 +417,28 @@ void Console::draw()
             {
                 nim::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
                 nim::NewLine();
+
+                const auto& renderStats = RenderStats::getLastFrame();
+                nim::Text("Draw Calls: %zu", renderStats.drawCalls);
+                nim::Text("Vertices: %zu", renderStats.vertexCount);
+                nim::Text("Drawables: %zu drawn, %zu culled, %zu batched",
+                    renderStats.drawablesDrawn, renderStats.drawablesCulled, renderStats.batchedDrawables);
+                nim::Text("State Changes: %zu texture, %zu shader, %zu blend mode",
+                    renderStats.textureChanges, renderStats.shaderChanges, renderStats.blendModeChanges);
+                nim::Text("Scissor Changes: %zu", renderStats.scissorChanges);
+                nim::Text("Render Target Changes: %zu", renderStats.renderTargetChanges);
+
+                const auto& history = RenderStats::getHistory();
+                const auto offset = static_cast<int>(RenderStats::getHistoryOffset());
+                nim::PlotLines("Draw Calls", [](void* data, int idx)
+                {
+                    return static_cast<float>(static_cast<const RenderStats*>(data)[idx].drawCalls);
+                }, const_cast<RenderStats*>(history.data()), static_cast<int>(history.size()), offset, nullptr, 0.f, FLT_MAX, ImVec2(0.f, 60.f));
+                nim::PlotLines("Vertices", [](void* data, int idx)
+                {
+                    return static_cast<float>(static_cast<const RenderStats*>(data)[idx].vertexCount);
+                }, const_cast<RenderStats*>(history.data()), static_cast<int>(history.size()), offset, nullptr, 0.f, FLT_MAX, ImVec2(0.f, 60.f));
+                nim::NewLine();
                 for (auto& line : m_debugLines)
                 {
                     ImGui::TextUnformatted(line.c_str());
@@ -574,6 +597,29 @@ void Console::init()
         App::quit();
     });
 
+    //records messages and events to a trace file
+    addCommand("record_start",
+        [](const std::string& param)
+    {
+        if (param.empty())
+        {
+            Console::print("Usage: record_start <file> where <file> is the path of the trace file to write");
+        }
+        else if (auto* app = App::getActiveInstance(); app)
+        {
+            app->startRecording(param);
+        }
+    });
+
+    addCommand("record_stop",
+        [](const std::string&)
+    {
+        if (auto* app = App::getActiveInstance(); app)
+        {
+            app->stopRecording();
+        }
+    });
+
 
     //loads any convars which may have been saved
     convars.loadFromFile(FileSystem::getConfigDirectory(APP_NAME) + convarName);
@@ -0,0 +1,341 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include "xyginext/core/JobSystem.hpp"
+#include "xyginext/core/Assert.hpp"
+
+#include <SFML/System/Clock.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace xy;
+
+namespace
+{
+    //index of the calling thread's queue in the active scheduler.
+    //threads which aren't workers all share the last queue
+    thread_local std::size_t threadQueue = std::numeric_limits<std::size_t>::max();
+
+    struct Task final
+    {
+        const char* tag = nullptr;
+        JobSystem::Job job;
+        JobSystem::Counter* counter = nullptr;
+    };
+
+    struct TaskQueue final
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+}
+
+namespace xy
+{
+    namespace Detail
+    {
+        class JobScheduler final
+        {
+        public:
+            explicit JobScheduler(std::size_t workerCount)
+                : m_pendingCount(0),
+                m_running       (true)
+            {
+                //one queue per worker plus one shared by other threads
+                for (auto i = 0u; i < workerCount + 1; ++i)
+                {
+                    m_queues.emplace_back(std::make_unique<TaskQueue>());
+                }
+
+                for (auto i = 0u; i < workerCount; ++i)
+                {
+                    m_threads.emplace_back(&JobScheduler::threadFunc, this, i);
+                }
+            }
+
+            ~JobScheduler()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_running = false;
+                }
+                m_condition.notify_all();
+
+                for (auto& t : m_threads)
+                {
+                    t.join();
+                }
+            }
+
+            JobScheduler(const JobScheduler&) = delete;
+            JobScheduler(JobScheduler&&) = delete;
+            JobScheduler& operator = (const JobScheduler&) = delete;
+            JobScheduler& operator = (JobScheduler&&) = delete;
+
+            std::size_t getWorkerCount() const { return m_threads.size(); }
+
+            void setProfileCallback(const JobSystem::ProfileCallback& cb) { m_profileCallback = cb; }
+
+            void push(const char* tag, JobSystem::Job job, JobSystem::Counter& counter)
+            {
+                counter.m_count.fetch_add(1, std::memory_order_relaxed);
+
+                if (m_threads.empty())
+                {
+                    execute(tag, job);
+                    complete(counter);
+                    return;
+                }
+
+                {
+                    auto& queue = *m_queues[getQueueIndex()];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.tasks.push_back({ tag, std::move(job), &counter });
+                }
+                m_pendingCount.fetch_add(1, std::memory_order_release);
+
+                //locking here prevents the notification arriving between a
+                //sleeping thread testing the pending count and waiting on it
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                }
+                m_condition.notify_all();
+            }
+
+            void wait(JobSystem::Counter& counter)
+            {
+                const auto queueIndex = getQueueIndex();
+                while (!counter.done())
+                {
+                    if (!tryRunTask(queueIndex))
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_condition.wait(lock, [&]()
+                        {
+                            return counter.done() || m_pendingCount.load(std::memory_order_acquire) > 0;
+                        });
+                    }
+                }
+            }
+
+            void execute(const char* tag, const JobSystem::Job& job)
+            {
+                if (m_profileCallback)
+                {
+                    sf::Clock clock;
+                    job();
+                    m_profileCallback(tag, JobSystem::getThreadIndex(), clock.getElapsedTime());
+                }
+                else
+                {
+                    job();
+                }
+            }
+
+        private:
+            std::vector<std::unique_ptr<TaskQueue>> m_queues;
+            std::vector<std::thread> m_threads;
+            std::atomic<std::size_t> m_pendingCount;
+
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+            bool m_running;
+
+            JobSystem::ProfileCallback m_profileCallback;
+
+            std::size_t getQueueIndex() const
+            {
+                return std::min(threadQueue, m_queues.size() - 1);
+            }
+
+            void complete(JobSystem::Counter& counter)
+            {
+                if (counter.m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                    }
+                    m_condition.notify_all();
+                }
+            }
+
+            bool tryRunTask(std::size_t queueIndex)
+            {
+                Task task;
+                if (!popTask(queueIndex, task))
+                {
+                    return false;
+                }
+
+                execute(task.tag, task.job);
+                complete(*task.counter);
+                return true;
+            }
+
+            bool popTask(std::size_t queueIndex, Task& dst)
+            {
+                if (m_pendingCount.load(std::memory_order_acquire) == 0)
+                {
+                    return false;
+                }
+
+                //take the newest task from our own queue...
+                {
+                    auto& queue = *m_queues[queueIndex];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (!queue.tasks.empty())
+                    {
+                        dst = std::move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                        m_pendingCount.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+
+                //...else steal the oldest from someone else's
+                for (auto i = 1u; i < m_queues.size(); ++i)
+                {
+                    auto& queue = *m_queues[(queueIndex + i) % m_queues.size()];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (!queue.tasks.empty())
+                    {
+                        dst = std::move(queue.tasks.front());
+                        queue.tasks.pop_front();
+                        m_pendingCount.fetch_sub(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void threadFunc(std::size_t index)
+            {
+                threadQueue = index;
+
+                while (true)
+                {
+                    if (!tryRunTask(index))
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_condition.wait(lock, [this]()
+                        {
+                            return !m_running || m_pendingCount.load(std::memory_order_acquire) > 0;
+                        });
+
+                        if (!m_running)
+                        {
+                            return;
+                        }
+                    }
+                }
+            }
+        };
+    }
+}
+
+namespace
+{
+    std::unique_ptr<Detail::JobScheduler>& getScheduler()
+    {
+        //the calling thread also executes jobs, so leave a core for it
+        static std::unique_ptr<Detail::JobScheduler> scheduler =
+            std::make_unique<Detail::JobScheduler>(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return scheduler;
+    }
+}
+
+void JobSystem::setWorkerCount(std::size_t count)
+{
+    XY_ASSERT(threadQueue == std::numeric_limits<std::size_t>::max(), "Worker count cannot be set from within a job");
+
+    auto& scheduler = getScheduler();
+    if (scheduler->getWorkerCount() != count)
+    {
+        scheduler.reset();
+        scheduler = std::make_unique<Detail::JobScheduler>(count);
+    }
+}
+
+std::size_t JobSystem::getWorkerCount()
+{
+    return getScheduler()->getWorkerCount();
+}
+
+std::size_t JobSystem::getThreadIndex()
+{
+    return (threadQueue == std::numeric_limits<std::size_t>::max()) ? 0 : threadQueue + 1;
+}
+
+void JobSystem::schedule(const char* tag, Job job, Counter& counter)
+{
+    XY_ASSERT(job, "Job function is empty");
+    getScheduler()->push(tag, std::move(job), counter);
+}
+
+void JobSystem::wait(Counter& counter)
+{
+    getScheduler()->wait(counter);
+}
+
+void JobSystem::parallelFor(const char* tag, std::size_t count, std::size_t grainSize, const RangeFunc& func)
+{
+    auto& scheduler = *getScheduler();
+    grainSize = std::max(grainSize, std::size_t(1));
+
+    if (count <= grainSize
+        || scheduler.getWorkerCount() == 0)
+    {
+        if (count > 0)
+        {
+            scheduler.execute(tag, [&]() { func(0, count); });
+        }
+        return;
+    }
+
+    //queue the later chunks and process the first here
+    Counter counter;
+    for (auto begin = grainSize; begin < count; begin += grainSize)
+    {
+        const auto end = std::min(begin + grainSize, count);
+        scheduler.push(tag, [&func, begin, end]() { func(begin, end); }, counter);
+    }
+    scheduler.execute(tag, [&]() { func(0, grainSize); });
+    scheduler.wait(counter);
+}
+
+void JobSystem::setProfileCallback(const ProfileCallback& callback)
+{
+    getScheduler()->setProfileCallback(callback);
+}
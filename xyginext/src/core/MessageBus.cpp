@@ -28,29 +28,131 @@ source distribution.
 #include "xyginext/core/MessageBus.hpp"
 #include "xyginext/core/Log.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
 using namespace xy;
 
 namespace
 {
-    //max msg size is 128 bytes, so 128 messages
-    //maximum per frame is 16384 bytes
-    const std::size_t bufferSize = 16384u;
+    //max msg size is 128 bytes, so each block holds at least 64 messages.
+    //blocks are chained together when a frame posts more than this
+    const std::size_t BlockSize = 16384u;
+
+    //threads posting via postFromThread() usually post far fewer messages
+    const std::size_t ProducerBlockSize = 4096u;
+
+    //identifies a bus in the thread local producer lists, as a new bus
+    //may be created at the address of a destroyed one
+    std::atomic<std::uint64_t> nextBusUID(1);
 }
 
+//blocks are written by a single producer thread and read by the thread
+//which owns the bus. The producer publishes each message by updating
+//'committed', and links the next block once this one is full.
+struct MessageBus::ProducerBlock final
+{
+    std::unique_ptr<char[]> data = std::make_unique<char[]>(ProducerBlockSize);
+    std::atomic<std::size_t> committed = 0;
+    std::atomic<ProducerBlock*> next = nullptr;
+    ProducerBlock* nextFree = nullptr;
+};
+
+struct MessageBus::Producer final
+{
+    Producer* nextProducer = nullptr; //never modified once the producer is published
+
+    //only used by the producer thread
+    ProducerBlock* writeBlock = nullptr;
+    std::size_t writeOffset = 0;
+    ProducerBlock* freeBlocks = nullptr;
+
+    //blocks which have been read are returned to the producer via this list
+    std::atomic<ProducerBlock*> returnedBlocks = nullptr;
+
+    //only used by the thread which reads the bus
+    ProducerBlock* readBlock = nullptr;
+    std::size_t readOffset = 0;
+
+    ProducerBlock* getFreeBlock()
+    {
+        if (!freeBlocks)
+        {
+            freeBlocks = returnedBlocks.exchange(nullptr, std::memory_order_acquire);
+        }
+
+        if (freeBlocks)
+        {
+            auto* block = freeBlocks;
+            freeBlocks = block->nextFree;
+
+            block->committed.store(0, std::memory_order_relaxed);
+            block->next.store(nullptr, std::memory_order_relaxed);
+            block->nextFree = nullptr;
+            return block;
+        }
+        return new ProducerBlock;
+    }
+};
+
 MessageBus::MessageBus()
-    : m_currentBuffer   (bufferSize),
-    m_pendingBuffer     (bufferSize),
-    m_inPointer         (m_pendingBuffer.data()),
-    m_outPointer        (m_currentBuffer.data()),
+    : m_scratchBuffer   (BlockSize),
+    m_inPointer         (nullptr),
+    m_inEnd             (nullptr),
+    m_outPointer        (nullptr),
+    m_outBlock          (0),
     m_currentCount      (0),
     m_pendingCount      (0),
-    m_enabled           (true)
-{}
+    m_pendingBytes      (0),
+    m_enabled           (true),
+    m_producers         (nullptr),
+    m_uid               (nextBusUID++)
+{
+    m_currentBlocks.push_back(getFreeBlock(BlockSize));
+    m_outPointer = m_currentBlocks.back().data.get();
+
+    addPendingBlock(BlockSize);
+}
+
+MessageBus::~MessageBus()
+{
+    auto deleteList = [](ProducerBlock* block, bool followNext)
+    {
+        while (block)
+        {
+            auto* next = followNext ? block->next.load() : block->nextFree;
+            delete block;
+            block = next;
+        }
+    };
+
+    auto* producer = m_producers.load();
+    while (producer)
+    {
+        deleteList(producer->readBlock, true);
+        deleteList(producer->freeBlocks, false);
+        deleteList(producer->returnedBlocks.load(), false);
+
+        auto* next = producer->nextProducer;
+        delete producer;
+        producer = next;
+    }
+}
 
 const Message& MessageBus::poll()
 {
+    //move to the next block once we've read all of this one
+    while (m_outPointer == m_currentBlocks[m_outBlock].data.get() + m_currentBlocks[m_outBlock].used)
+    {
+        m_outBlock++;
+        XY_ASSERT(m_outBlock < m_currentBlocks.size(), "Polled empty message bus");
+        m_outPointer = m_currentBlocks[m_outBlock].data.get();
+    }
+
     const Message& m = *reinterpret_cast<Message*>(m_outPointer);
-    m_outPointer += (MessageSize + m.m_dataSize);
+    m_outPointer = align(static_cast<char*>(m.m_data) + m.m_dataSize, alignof(Message));
     m_currentCount--;
 
     return m;
@@ -60,11 +162,30 @@ bool MessageBus::empty()
 {
     if (m_currentCount == 0)
     {
-        m_currentBuffer.swap(m_pendingBuffer);
-        m_inPointer = m_pendingBuffer.data();
-        m_outPointer = m_currentBuffer.data();
+        mergeProducers();
+
+        m_pendingBlocks.back().used = m_inPointer - m_pendingBlocks.back().data.get();
+
+        m_stats.highWaterMark = std::max(m_stats.highWaterMark, m_pendingBytes);
+        m_stats.peakMessageCount = std::max(m_stats.peakMessageCount, m_pendingCount);
+
+        //the current blocks have all been read so can be reused
+        for (auto& block : m_currentBlocks)
+        {
+            block.used = 0;
+            m_freeBlocks.push_back(std::move(block));
+        }
+        m_currentBlocks.clear();
+        m_currentBlocks.swap(m_pendingBlocks);
+
+        m_outBlock = 0;
+        m_outPointer = m_currentBlocks[0].data.get();
         m_currentCount = m_pendingCount;
+
         m_pendingCount = 0;
+        m_pendingBytes = 0;
+        addPendingBlock(BlockSize);
+
         return true;
     }
     return false;
@@ -74,3 +195,178 @@ std::size_t MessageBus::pendingMessageCount() const
 {
     return m_pendingCount;
 }
+
+void MessageBus::resetStats()
+{
+    m_stats.highWaterMark = 0;
+    m_stats.peakMessageCount = 0;
+    std::fill(m_stats.messageCounts.begin(), m_stats.messageCounts.end(), 0);
+}
+
+//private
+void MessageBus::addPendingBlock(std::size_t minSize)
+{
+    if (!m_pendingBlocks.empty())
+    {
+        m_pendingBlocks.back().used = m_inPointer - m_pendingBlocks.back().data.get();
+    }
+
+    m_pendingBlocks.push_back(getFreeBlock(minSize));
+    m_inPointer = m_pendingBlocks.back().data.get();
+    m_inEnd = m_inPointer + m_pendingBlocks.back().size;
+}
+
+MessageBus::Block MessageBus::getFreeBlock(std::size_t minSize)
+{
+    auto result = std::find_if(m_freeBlocks.rbegin(), m_freeBlocks.rend(),
+        [minSize](const Block& block)
+    {
+        return block.size >= minSize;
+    });
+
+    if (result != m_freeBlocks.rend())
+    {
+        Block block = std::move(*result);
+        m_freeBlocks.erase(std::next(result).base());
+        return block;
+    }
+
+    Block block;
+    block.size = std::max(minSize, BlockSize);
+    block.data = std::make_unique<char[]>(block.size);
+    m_stats.blockCount++;
+
+    return block;
+}
+
+void MessageBus::countMessage(Message::ID id)
+{
+    if (id >= 0)
+    {
+        m_stats.messageCounts.resize(id + 1);
+        m_stats.messageCounts[id]++;
+    }
+}
+
+void MessageBus::postFromThread(Message::ID id, const void* data, std::size_t size, std::size_t alignment)
+{
+    if (!m_enabled.load(std::memory_order_relaxed)) return;
+
+    auto& producer = getProducer();
+
+    const std::size_t maxSize = MessageSize + alignment + size + alignof(Message);
+    if (ProducerBlockSize - producer.writeOffset < maxSize)
+    {
+        auto* block = producer.getFreeBlock();
+        producer.writeBlock->next.store(block, std::memory_order_release);
+        producer.writeBlock = block;
+        producer.writeOffset = 0;
+    }
+
+    char* base = producer.writeBlock->data.get();
+    char* start = base + producer.writeOffset;
+
+    Message* msg = new (start)Message();
+    msg->id = id;
+    msg->m_dataSize = size;
+    msg->m_data = align(start + MessageSize, alignment);
+    std::memcpy(msg->m_data, data, size);
+
+    producer.writeOffset = align(static_cast<char*>(msg->m_data) + size, alignof(Message)) - base;
+    producer.writeBlock->committed.store(producer.writeOffset, std::memory_order_release);
+}
+
+MessageBus::Producer& MessageBus::getProducer()
+{
+    thread_local std::vector<std::pair<std::uint64_t, Producer*>> producers;
+
+    for (const auto& [uid, producer] : producers)
+    {
+        if (uid == m_uid)
+        {
+            return *producer;
+        }
+    }
+
+    auto* producer = new Producer;
+    producer->writeBlock = new ProducerBlock;
+    producer->readBlock = producer->writeBlock;
+
+    producer->nextProducer = m_producers.load(std::memory_order_relaxed);
+    while (!m_producers.compare_exchange_weak(producer->nextProducer, producer,
+        std::memory_order_release, std::memory_order_relaxed)) {}
+
+    producers.emplace_back(m_uid, producer);
+    return *producer;
+}
+
+void MessageBus::mergeProducers()
+{
+    auto* producer = m_producers.load(std::memory_order_acquire);
+    while (producer)
+    {
+        while (true)
+        {
+            auto* block = producer->readBlock;
+
+            //read next first - if it's set the producer has finished with this block
+            auto* next = block->next.load(std::memory_order_acquire);
+            const auto committed = block->committed.load(std::memory_order_acquire);
+
+            char* base = block->data.get();
+            while (producer->readOffset < committed)
+            {
+                const auto& msg = *reinterpret_cast<Message*>(base + producer->readOffset);
+                mergeMessage(msg);
+                producer->readOffset = align(static_cast<char*>(msg.m_data) + msg.m_dataSize, alignof(Message)) - base;
+            }
+
+            if (!next)
+            {
+                break;
+            }
+
+            //hand the block back to the producer for reuse
+            block->nextFree = producer->returnedBlocks.load(std::memory_order_relaxed);
+            while (!producer->returnedBlocks.compare_exchange_weak(block->nextFree, block,
+                std::memory_order_release, std::memory_order_relaxed)) {}
+
+            producer->readBlock = next;
+            producer->readOffset = 0;
+        }
+        producer = producer->nextProducer;
+    }
+}
+
+void MessageBus::mergeMessage(const Message& src)
+{
+    //the original type is unknown here, so match the alignment of the source data
+    const auto address = reinterpret_cast<std::uintptr_t>(src.m_data);
+    const std::size_t alignment = std::min(address & (~address + 1), alignof(std::max_align_t));
+
+    const std::size_t maxSize = MessageSize + alignment + src.m_dataSize + alignof(Message);
+    if (static_cast<std::size_t>(m_inEnd - m_inPointer) < maxSize)
+    {
+        addPendingBlock(maxSize);
+    }
+
+    Message* msg = new (m_inPointer)Message();
+    msg->id = src.id;
+    msg->m_dataSize = src.m_dataSize;
+    msg->m_data = align(m_inPointer + MessageSize, alignment);
+    std::memcpy(msg->m_data, src.m_data, src.m_dataSize);
+
+    auto* next = align(static_cast<char*>(msg->m_data) + src.m_dataSize, alignof(Message));
+    m_pendingBytes += (next - m_inPointer);
+    m_inPointer = next;
+    m_pendingCount++;
+
+    if (src.id >= 0 && static_cast<std::size_t>(src.id) < m_stats.messageCounts.size())
+    {
+        m_stats.messageCounts[src.id]++;
+    }
+    else
+    {
+        countMessage(src.id);
+    }
+}
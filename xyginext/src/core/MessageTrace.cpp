@@ -0,0 +1,317 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include "xyginext/core/MessageTrace.hpp"
+#include "xyginext/core/MessageBus.hpp"
+#include "xyginext/core/Log.hpp"
+#include "xyginext/ecs/Scene.hpp"
+
+#include <array>
+#include <cstring>
+
+using namespace xy;
+
+namespace
+{
+    const std::array<char, 4> TraceIdent = { 'X', 'Y', 'M', 'T' };
+    const sf::Uint32 TraceVersion = 1;
+
+    struct TraceHeader final
+    {
+        std::array<char, 4> ident = TraceIdent;
+        sf::Uint32 version = TraceVersion;
+        sf::Uint32 eventSize = sizeof(sf::Event);
+    };
+
+    struct FrameHeader final
+    {
+        sf::Uint32 frameNumber = 0;
+        float frameTime = 0.f;
+        sf::Uint32 eventCount = 0;
+        sf::Uint32 messageCount = 0;
+    };
+
+    struct MessageHeader final
+    {
+        Message::ID id = -1;
+        sf::Uint32 size = 0;
+    };
+
+    template <typename T>
+    void append(std::vector<char>& dst, const T& data)
+    {
+        const auto* bytes = reinterpret_cast<const char*>(&data);
+        dst.insert(dst.end(), bytes, bytes + sizeof(T));
+    }
+}
+
+MessageRecorder::MessageRecorder()
+    : m_eventCount  (0),
+    m_messageCount  (0),
+    m_frameCount    (0)
+{
+
+}
+
+MessageRecorder::~MessageRecorder()
+{
+    close();
+}
+
+//public
+bool MessageRecorder::open(const std::string& path)
+{
+    close();
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        Logger::log("Failed to open " + path + " for recording", Logger::Type::Error);
+        return false;
+    }
+
+    TraceHeader header;
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    m_eventData.clear();
+    m_messageData.clear();
+    m_eventCount = 0;
+    m_messageCount = 0;
+    m_frameCount = 0;
+
+    return true;
+}
+
+void MessageRecorder::close()
+{
+    if (m_file.is_open())
+    {
+        if (m_eventCount != 0 || m_messageCount != 0)
+        {
+            endFrame(0.f);
+        }
+        m_file.close();
+    }
+}
+
+void MessageRecorder::recordEvent(const sf::Event& evt)
+{
+    if (m_file.is_open())
+    {
+        append(m_eventData, evt);
+        m_eventCount++;
+    }
+}
+
+void MessageRecorder::recordMessage(const Message& msg)
+{
+    if (m_file.is_open())
+    {
+        MessageHeader header;
+        header.id = msg.id;
+        header.size = static_cast<sf::Uint32>(msg.m_dataSize);
+        append(m_messageData, header);
+
+        const auto* bytes = static_cast<const char*>(msg.m_data);
+        m_messageData.insert(m_messageData.end(), bytes, bytes + msg.m_dataSize);
+        m_messageCount++;
+    }
+}
+
+void MessageRecorder::endFrame(float dt)
+{
+    if (m_file.is_open())
+    {
+        FrameHeader header;
+        header.frameNumber = m_frameCount++;
+        header.frameTime = dt;
+        header.eventCount = m_eventCount;
+        header.messageCount = m_messageCount;
+
+        m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        m_file.write(m_eventData.data(), m_eventData.size());
+        m_file.write(m_messageData.data(), m_messageData.size());
+
+        m_eventData.clear();
+        m_messageData.clear();
+        m_eventCount = 0;
+        m_messageCount = 0;
+    }
+}
+
+//------------------------------------------------------//
+
+MessagePlayer::MessagePlayer()
+    : m_readPosition(0),
+    m_frameNumber   (0),
+    m_frameTime     (0.f)
+{
+
+}
+
+//public
+bool MessagePlayer::loadFromFile(const std::string& path)
+{
+    m_trace.clear();
+    rewind();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        Logger::log("Failed to open trace " + path, Logger::Type::Error);
+        return false;
+    }
+
+    const auto size = file.tellg();
+    file.seekg(0);
+    m_trace.resize(static_cast<std::size_t>(size));
+    file.read(m_trace.data(), size);
+
+    TraceHeader header;
+    if (!read(header) || header.ident != TraceIdent)
+    {
+        Logger::log(path + ": not a valid message trace", Logger::Type::Error);
+        m_trace.clear();
+        return false;
+    }
+
+    if (header.version != TraceVersion || header.eventSize != sizeof(sf::Event))
+    {
+        Logger::log(path + ": message trace was created with an incompatible version or platform", Logger::Type::Error);
+        m_trace.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool MessagePlayer::nextFrame()
+{
+    m_events.clear();
+    m_messages.clear();
+    m_messageData.clear();
+
+    FrameHeader header;
+    if (!read(header))
+    {
+        return false;
+    }
+    m_frameNumber = header.frameNumber;
+    m_frameTime = header.frameTime;
+
+    for (auto i = 0u; i < header.eventCount; ++i)
+    {
+        sf::Event evt;
+        if (!read(evt))
+        {
+            return false;
+        }
+        m_events.push_back(evt);
+    }
+
+    //copy message data to aligned storage, then point the messages at it
+    //once the storage is no longer going to be resized
+    std::vector<std::pair<MessageHeader, std::size_t>> messageHeaders;
+    for (auto i = 0u; i < header.messageCount; ++i)
+    {
+        MessageHeader msgHeader;
+        if (!read(msgHeader)
+            || m_trace.size() - m_readPosition < msgHeader.size)
+        {
+            return false;
+        }
+
+        const auto offset = m_messageData.size();
+        m_messageData.resize(offset + (msgHeader.size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+        std::memcpy(m_messageData.data() + offset, m_trace.data() + m_readPosition, msgHeader.size);
+        m_readPosition += msgHeader.size;
+
+        messageHeaders.emplace_back(msgHeader, offset);
+    }
+
+    for (const auto& [msgHeader, offset] : messageHeaders)
+    {
+        auto& msg = m_messages.emplace_back();
+        msg.id = msgHeader.id;
+        msg.m_data = m_messageData.data() + offset;
+        msg.m_dataSize = msgHeader.size;
+    }
+
+    return true;
+}
+
+void MessagePlayer::rewind()
+{
+    m_readPosition = m_trace.empty() ? 0 : sizeof(TraceHeader);
+    m_frameNumber = 0;
+    m_frameTime = 0.f;
+    m_events.clear();
+    m_messages.clear();
+    m_messageData.clear();
+}
+
+bool MessagePlayer::playFrame(Scene& scene, MessageBus& messageBus)
+{
+    if (!nextFrame())
+    {
+        return false;
+    }
+
+    for (const auto& evt : m_events)
+    {
+        scene.forwardEvent(evt);
+    }
+
+    for (const auto& msg : m_messages)
+    {
+        scene.forwardMessage(msg);
+    }
+
+    scene.update(m_frameTime);
+
+    while (!messageBus.empty())
+    {
+        messageBus.poll();
+    }
+
+    return true;
+}
+
+//private
+template <typename T>
+bool MessagePlayer::read(T& dst)
+{
+    if (m_trace.size() - m_readPosition < sizeof(T))
+    {
+        return false;
+    }
+
+    std::memcpy(&dst, m_trace.data() + m_readPosition, sizeof(T));
+    m_readPosition += sizeof(T);
+    return true;
+}
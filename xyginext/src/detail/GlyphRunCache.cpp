@@ -0,0 +1,414 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include "GlyphRunCache.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace xy;
+using namespace xy::Detail;
+
+namespace
+{
+    //keyed by hash, so strings are stored only once in the runs themselves
+    using CacheMap = std::unordered_multimap<std::size_t, std::shared_ptr<GlyphRun>>;
+    CacheMap& getCache()
+    {
+        static CacheMap cache;
+        return cache;
+    }
+
+    //grows when most cached runs are in use so that eviction stays amortised
+    std::size_t evictionThreshold = GlyphRunCache::MaxSize;
+
+    std::size_t glyphLookups = 0;
+    std::size_t kerningLookups = 0;
+
+    void addQuad(std::vector<sf::Vertex>& vertices, sf::Vector2f position, const sf::Glyph& glyph, float outlineThickness = 0.f)
+    {
+        float left = glyph.bounds.left - outlineThickness;
+        float top = glyph.bounds.top - outlineThickness;
+        float right = glyph.bounds.left + glyph.bounds.width - outlineThickness;
+        float bottom = glyph.bounds.top + glyph.bounds.height - outlineThickness;
+
+        float u1 = static_cast<float>(glyph.textureRect.left);
+        float v1 = static_cast<float>(glyph.textureRect.top);
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+        float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height);
+
+        vertices.emplace_back(sf::Vector2f(position.x + left, position.y + top), sf::Vector2f(u1, v1));
+        vertices.emplace_back(sf::Vector2f(position.x + right, position.y + top), sf::Vector2f(u2, v1));
+        vertices.emplace_back(sf::Vector2f(position.x + left, position.y + bottom), sf::Vector2f(u1, v2));
+        vertices.emplace_back(sf::Vector2f(position.x + left, position.y + bottom), sf::Vector2f(u1, v2));
+        vertices.emplace_back(sf::Vector2f(position.x + right, position.y + top), sf::Vector2f(u2, v1));
+        vertices.emplace_back(sf::Vector2f(position.x + right, position.y + bottom), sf::Vector2f(u2, v2));
+    }
+}
+
+//public
+std::shared_ptr<const GlyphRun> GlyphRunCache::get(const GlyphRunParams& params, const sf::String& string, std::shared_ptr<const GlyphRun> previous)
+{
+    //the caller's font is still alive so its own run needs no validation
+    if (previous && previous->params == params && previous->string == string)
+    {
+        return previous;
+    }
+
+    auto& cache = getCache();
+    const auto hashValue = hash(params, string);
+    auto [first, last] = cache.equal_range(hashValue);
+    for (auto it = first; it != last;)
+    {
+        if (it->second->params == params && it->second->string == string)
+        {
+            if (isCurrent(*it->second))
+            {
+                return it->second;
+            }
+
+            //the font was replaced by another at the same address
+            it = cache.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    std::shared_ptr<GlyphRun> run;
+    std::size_t start = 0;
+    if (previous && previous->params == params)
+    {
+        //resume from the prefix this string shares with the previous one
+        const auto& prevString = previous->string;
+        const auto count = std::min(prevString.getSize(), string.getSize());
+        while (start < count && prevString[start] == string[start])
+        {
+            start++;
+        }
+
+        //if nothing else uses the previous run take it out of the cache and reuse it
+        if (previous.use_count() == 2)
+        {
+            auto [prevFirst, prevLast] = cache.equal_range(previous->hash);
+            for (auto it = prevFirst; it != prevLast; ++it)
+            {
+                if (it->second == previous)
+                {
+                    cache.erase(it);
+                    break;
+                }
+            }
+        }
+
+        if (previous.use_count() == 1)
+        {
+            //runs are only created non-const by the cache, so this is safe once we are the only owner
+            run = std::const_pointer_cast<GlyphRun>(previous);
+            run->cursors.resize(start + 1);
+            run->vertices.resize(run->cursors.back().vertexCount);
+        }
+        else if (start > 0)
+        {
+            run = std::make_shared<GlyphRun>();
+            const auto& cursor = previous->cursors[start];
+            run->cursors.assign(previous->cursors.begin(), previous->cursors.begin() + start + 1);
+            run->vertices.assign(previous->vertices.begin(), previous->vertices.begin() + cursor.vertexCount);
+        }
+        previous.reset();
+    }
+
+    if (!run)
+    {
+        run = std::make_shared<GlyphRun>();
+        start = 0;
+    }
+    else if (start == 0)
+    {
+        run->cursors.clear();
+        run->vertices.clear();
+    }
+
+    run->params = params;
+    run->string = string;
+    run->hash = hashValue;
+    layout(*run, start);
+
+    if (cache.size() >= evictionThreshold)
+    {
+        evict();
+    }
+    cache.insert(std::make_pair(hashValue, run));
+
+    return run;
+}
+
+std::size_t GlyphRunCache::size()
+{
+    return getCache().size();
+}
+
+void GlyphRunCache::clear()
+{
+    getCache().clear();
+    evictionThreshold = MaxSize;
+}
+
+std::size_t GlyphRunCache::getGlyphLookupCount()
+{
+    return glyphLookups;
+}
+
+std::size_t GlyphRunCache::getKerningLookupCount()
+{
+    return kerningLookups;
+}
+
+//private
+std::size_t GlyphRunCache::hash(const GlyphRunParams& params, const sf::String& string)
+{
+    //FNV-1a over the string and layout parameters
+    std::uint64_t hash = 14695981039346656037ull;
+    auto combine = [&hash](std::uint64_t value)
+    {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+
+    sf::Uint32 outline = 0;
+    std::memcpy(&outline, &params.outlineThickness, sizeof(outline));
+    sf::Uint32 spacing = 0;
+    std::memcpy(&spacing, &params.verticalSpacing, sizeof(spacing));
+
+    combine(reinterpret_cast<std::uintptr_t>(params.font));
+    combine(params.charSize);
+    combine(outline);
+    combine(spacing);
+    for (auto c : string)
+    {
+        combine(c);
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+void GlyphRunCache::layout(GlyphRun& run, std::size_t start)
+{
+    const auto& params = run.params;
+    const auto& string = run.string;
+    auto& vertices = run.vertices;
+    auto& cursors = run.cursors;
+    cursors.reserve(string.getSize() + 1);
+
+    if (!params.font || string.isEmpty())
+    {
+        cursors.resize(string.getSize() + 1);
+        run.bounds = {};
+        return;
+    }
+
+    GlyphRun::Cursor cursor;
+    if (start > 0)
+    {
+        //resume from the state before the first new character
+        cursor = cursors.back();
+        cursors.pop_back();
+    }
+    else
+    {
+        cursor.y = static_cast<float>(params.charSize);
+        cursor.minY = cursor.y;
+    }
+
+    //update glyphs - TODO here we could check for bold fonts in the future
+    const auto* font = params.font;
+    const auto charSize = params.charSize;
+    const auto outlineThickness = params.outlineThickness;
+    float xOffset = static_cast<float>(font->getGlyph(L' ', charSize, false).advance);
+    glyphLookups++;
+    float yOffset = static_cast<float>(font->getLineSpacing(charSize));
+
+    for (auto i = start; i < string.getSize(); ++i)
+    {
+        cursor.vertexCount = vertices.size();
+        cursors.push_back(cursor);
+
+        auto& x = cursor.x;
+        auto& y = cursor.y;
+        sf::Uint32 currChar = string[i];
+
+        x += font->getKerning(cursor.prevChar, currChar, charSize);
+        kerningLookups++;
+        cursor.prevChar = currChar;
+
+        //whitespace chars
+        if (currChar == ' ' || currChar == '\t' || currChar == '\n')
+        {
+            cursor.minX = std::min(cursor.minX, x);
+            cursor.minY = std::min(cursor.minY, y);
+
+            switch (currChar)
+            {
+            default: break;
+            case ' ':
+                x += xOffset;
+                break;
+            case '\t':
+                x += xOffset * 4.f; //4 spaces for tab suckas
+                break;
+            case '\n':
+                y += yOffset + params.verticalSpacing;
+                x = 0.f;
+                break;
+            }
+
+            cursor.maxX = std::max(cursor.maxX, x);
+            cursor.maxY = std::max(cursor.maxY, y);
+
+            continue; //skip quad for whitespace
+        }
+
+        //create the quads.
+        auto addOutline = [&]()
+        {
+            const auto& glyph = font->getGlyph(currChar, charSize, false, outlineThickness);
+            glyphLookups++;
+            addQuad(vertices, sf::Vector2f(x, y), glyph, outlineThickness);
+
+            cursor.minX = std::min(cursor.minX, x + glyph.bounds.left - outlineThickness);
+            cursor.maxX = std::max(cursor.maxX, x + glyph.bounds.left + glyph.bounds.width - outlineThickness);
+            cursor.minY = std::min(cursor.minY, y + glyph.bounds.top - outlineThickness);
+            cursor.maxY = std::max(cursor.maxY, y + glyph.bounds.top + glyph.bounds.height - outlineThickness);
+        };
+
+        //if outline is larger, add first
+        if (outlineThickness > 0)
+        {
+            addOutline();
+        }
+
+        const auto& glyph = font->getGlyph(currChar, charSize, false);
+        glyphLookups++;
+        addQuad(vertices, sf::Vector2f(x, y), glyph);
+
+        //else add outline on top
+        if (outlineThickness < 0)
+        {
+            addOutline();
+        }
+
+        //only do this if not outlined
+        if (outlineThickness == 0)
+        {
+            cursor.minX = std::min(cursor.minX, x + glyph.bounds.left);
+            cursor.maxX = std::max(cursor.maxX, x + glyph.bounds.left + glyph.bounds.width);
+            cursor.minY = std::min(cursor.minY, y + glyph.bounds.top);
+            cursor.maxY = std::max(cursor.maxY, y + glyph.bounds.top + glyph.bounds.height);
+        }
+
+        x += glyph.advance;
+    }
+    cursor.vertexCount = vertices.size();
+    cursors.push_back(cursor);
+
+    run.bounds.left = cursor.minX;
+    run.bounds.top = cursor.minY;
+    run.bounds.width = cursor.maxX - cursor.minX;
+    run.bounds.height = cursor.maxY - cursor.minY;
+}
+
+bool GlyphRunCache::isCurrent(const GlyphRun& run)
+{
+    const auto& params = run.params;
+    if (!params.font)
+    {
+        return true;
+    }
+
+    //fetching the glyphs renders any which are missing from the font's texture,
+    //so the run is valid if every glyph is still in the same place on the page
+    std::size_t vertex = 0;
+    auto matches = [&](const sf::Glyph& glyph)
+    {
+        glyphLookups++;
+
+        const auto& topLeft = run.vertices[vertex].texCoords;
+        const auto& bottomRight = run.vertices[vertex + 5].texCoords;
+        vertex += 6;
+
+        return topLeft.x == static_cast<float>(glyph.textureRect.left)
+            && topLeft.y == static_cast<float>(glyph.textureRect.top)
+            && bottomRight.x == static_cast<float>(glyph.textureRect.left + glyph.textureRect.width)
+            && bottomRight.y == static_cast<float>(glyph.textureRect.top + glyph.textureRect.height);
+    };
+
+    const auto* font = params.font;
+    for (auto c : run.string)
+    {
+        if (c == ' ' || c == '\t' || c == '\n')
+        {
+            continue;
+        }
+
+        if (params.outlineThickness > 0
+            && !matches(font->getGlyph(c, params.charSize, false, params.outlineThickness)))
+        {
+            return false;
+        }
+
+        if (!matches(font->getGlyph(c, params.charSize, false)))
+        {
+            return false;
+        }
+
+        if (params.outlineThickness < 0
+            && !matches(font->getGlyph(c, params.charSize, false, params.outlineThickness)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GlyphRunCache::evict()
+{
+    //remove runs which are no longer used by any text
+    auto& cache = getCache();
+    for (auto it = cache.begin(); it != cache.end();)
+    {
+        if (it->second.use_count() == 1)
+        {
+            it = cache.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    evictionThreshold = std::max(MaxSize, cache.size() * 2);
+}
@@ -0,0 +1,149 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <SFML/System/String.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+namespace sf
+{
+    class Font;
+}
+
+namespace xy
+{
+    namespace Detail
+    {
+        /*!
+        \brief Everything other than the string which affects the layout of text
+        */
+        struct GlyphRunParams final
+        {
+            const sf::Font* font = nullptr;
+            sf::Uint32 charSize = 0;
+            float outlineThickness = 0.f;
+            float verticalSpacing = 0.f;
+
+            bool operator == (const GlyphRunParams& other) const
+            {
+                return font == other.font && charSize == other.charSize
+                    && outlineThickness == other.outlineThickness && verticalSpacing == other.verticalSpacing;
+            }
+        };
+
+        /*!
+        \brief The laid out, unaligned geometry of a string.
+        Vertices are white. When the outline thickness is not zero
+        every glyph is made of two quads, the outline quad first
+        if the thickness is positive, else the fill quad first.
+        */
+        struct GlyphRun final
+        {
+            GlyphRunParams params;
+            sf::String string;
+            std::size_t hash = 0;
+            std::vector<sf::Vertex> vertices;
+            sf::FloatRect bounds;
+
+            //layout state before each character, plus the final state, so
+            //layout can be resumed from any character of the string
+            struct Cursor final
+            {
+                float x = 0.f;
+                float y = 0.f;
+                float minX = 0.f;
+                float minY = 0.f;
+                float maxX = 0.f;
+                float maxY = 0.f;
+                sf::Uint32 prevChar = 0;
+                std::size_t vertexCount = 0;
+            };
+            std::vector<Cursor> cursors;
+        };
+
+        /*!
+        \brief Shares glyph runs between all Text components laying out the
+        same string with the same font, character size and outline.
+        Runs no longer referenced by any Text are evicted once the cache
+        grows beyond MaxSize, or twice the number of runs in use. Not thread safe - text is updated on the
+        main thread as laying out glyphs may modify the font texture.
+        */
+        class GlyphRunCache final
+        {
+        public:
+            static constexpr std::size_t MaxSize = 1024;
+
+            /*!
+            \brief Returns the run for the given string, laying it out if it
+            is not yet cached. Cached runs are checked against the font's
+            current glyphs before they are returned, and laid out again if
+            a different font now exists at the same address. If the previous run has the same parameters
+            then only the characters after the prefix which the strings have
+            in common are laid out, and if no other text is using the previous
+            run its storage is reused.
+            */
+            static std::shared_ptr<const GlyphRun> get(const GlyphRunParams&, const sf::String&, std::shared_ptr<const GlyphRun> previous);
+
+            /*!
+            \brief Number of runs currently cached
+            */
+            static std::size_t size();
+
+            /*!
+            \brief Removes all runs from the cache. Runs still in use
+            by Text components remain valid.
+            */
+            static void clear();
+
+            /*!
+            \brief Total number of calls made to sf::Font::getGlyph() when laying out runs
+            */
+            static std::size_t getGlyphLookupCount();
+
+            /*!
+            \brief Total number of calls made to sf::Font::getKerning() when laying out runs
+            */
+            static std::size_t getKerningLookupCount();
+
+        private:
+            static std::size_t hash(const GlyphRunParams&, const sf::String&);
+            static void layout(GlyphRun&, std::size_t);
+
+            //fonts are identified by address, so a cached run may belong to a destroyed
+            //font if another has since been created at the same address
+            static bool isCurrent(const GlyphRun&);
+            static void evict();
+        };
+    }
+}
@@ -28,16 +28,50 @@ source distribution.
 #include "xyginext/ecs/Component.hpp"
 #include "xyginext/ecs/Entity.hpp"
 
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+
+#include <unordered_map>
+
 using namespace xy;
 
+namespace
+{
+    sf::Mutex familyMutex;
+}
+
+std::size_t Detail::getComponentFamily(std::type_index type)
+{
+    static std::unordered_map<std::type_index, std::size_t> families;
+
+    sf::Lock lock(familyMutex);
+    auto result = families.find(type);
+    if (result == families.end())
+    {
+        result = families.insert(std::make_pair(type, families.size())).first;
+    }
+    return result->second;
+}
+
 ComponentManager::ID ComponentManager::getFromTypeID(std::type_index id)
 {
-    auto result = std::find(std::begin(m_IDs), std::end(m_IDs), id);
-    if (result == m_IDs.end())
+    const auto family = Detail::getComponentFamily(id);
+    if (family < m_IDs.size() && m_IDs[family] != InvalidID)
+    {
+        return m_IDs[family];
+    }
+    return assignID(family);
+}
+
+//private
+ComponentManager::ID ComponentManager::assignID(std::size_t family)
+{
+    XY_ASSERT(m_nextID < Detail::MaxComponents, "Max components have been allocated");
+
+    if (family >= m_IDs.size())
     {
-        XY_ASSERT(m_IDs.size() < Detail::MaxComponents, "Max components have been allocated");
-        m_IDs.push_back(id);
-        return static_cast<ID>(m_IDs.size() - 1);
+        m_IDs.resize(family + 1, InvalidID);
     }
-    return static_cast<ID>(std::distance(m_IDs.begin(), result));
+    m_IDs[family] = m_nextID++;
+    return m_IDs[family];
 }
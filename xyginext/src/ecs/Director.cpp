@@ -27,6 +27,9 @@ source distribution.
 
 #include "xyginext/ecs/Director.hpp"
 #include "xyginext/ecs/systems/CommandSystem.hpp"
+#include "xyginext/ecs/Scene.hpp"
+
+#include <algorithm>
 
 using namespace xy;
 
@@ -41,6 +44,32 @@ void Director::sendCommand(const Command& cmd)
     m_commandSystem->sendCommand(cmd);
 }
 
+void Director::subscribe(Message::ID id)
+{
+    XY_ASSERT(id >= 0, "Invalid message ID");
+    if (std::find(m_subscriptions.begin(), m_subscriptions.end(), id) == m_subscriptions.end())
+    {
+        m_subscriptions.push_back(id);
+        if (m_scene)
+        {
+            m_scene->m_directorSubscribersDirty = true;
+        }
+    }
+}
+
+void Director::unsubscribe(Message::ID id)
+{
+    auto result = std::find(m_subscriptions.begin(), m_subscriptions.end(), id);
+    if (result != m_subscriptions.end())
+    {
+        m_subscriptions.erase(result);
+        if (m_scene)
+        {
+            m_scene->m_directorSubscribersDirty = true;
+        }
+    }
+}
+
 Scene& Director::getScene()
 {
     XY_ASSERT(m_scene, "Missing scene - are you using this correctly?");
@@ -32,12 +32,12 @@ using namespace xy;
 
 namespace
 {
-    const sf::Uint32 IndexMask = (1 << Detail::IndexBits) - 1;
-    const sf::Uint32 GenerationMask = (1 << Detail::GenerationBits) - 1;
+    const Entity::ID IndexMask = (Entity::ID(1) << Detail::IndexBits) - 1;
+    const Entity::ID GenerationMask = (Entity::ID(1) << Detail::GenerationBits) - 1;
 }
 
 Entity::Entity(Entity::ID index, Entity::Generation generation)
-    : m_id          ((generation << Detail::IndexBits) | index),
+    : m_id          ((static_cast<Entity::ID>(generation) << Detail::IndexBits) | index),
     m_entityManager (nullptr)
 {
 
@@ -51,7 +51,7 @@ Entity::ID Entity::getIndex() const
 
 Entity::Generation Entity::getGeneration() const
 {
-    return (m_id >> Detail::IndexBits) & GenerationMask;
+    return static_cast<Entity::Generation>((m_id >> Detail::IndexBits) & GenerationMask);
 }
 
 //TODO fix this so that it goes through its parent scene.
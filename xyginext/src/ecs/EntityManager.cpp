@@ -26,7 +26,6 @@ source distribution.
 *********************************************************************/
 
 #include "xyginext/ecs/Entity.hpp"
-#include "xyginext/ecs/components/Transform.hpp"
 #include "xyginext/core/Assert.hpp"
 #include "xyginext/core/MessageBus.hpp"
 
@@ -35,11 +34,18 @@ using namespace xy;
 namespace
 {
     const std::size_t MinComponentMasks = 50;
+
+    const Entity::ID InvalidID = std::numeric_limits<Entity::ID>::max();
+    const Entity::ID MaxIndex = (Entity::ID(1) << Detail::IndexBits) - 1;
+    const Entity::Generation MaxGeneration = static_cast<Entity::Generation>((sf::Uint64(1) << Detail::GenerationBits) - 1);
 }
 
 EntityManager::EntityManager(MessageBus& mb, ComponentManager& cm, std::size_t poolSize)
     : m_messageBus      (mb),
     m_componentManager  (cm),
+    m_freeHead          (InvalidID),
+    m_freeTail          (InvalidID),
+    m_freeCount         (0),
     m_componentPools    (Detail::MaxComponents),
     m_initialPoolSize   (poolSize)
 {}
@@ -48,25 +54,32 @@ EntityManager::EntityManager(MessageBus& mb, ComponentManager& cm, std::size_t p
 Entity EntityManager::createEntity()
 {
     Entity::ID idx = 0;
-    if (m_generations.size() == Detail::MaxIDsPerGeneration)
+    if (m_freeCount > Detail::MinFreeIDs
+        || (m_freeCount > 0 && m_slots.size() > MaxIndex))
     {
-        idx = m_freeIDs.front();
-        m_freeIDs.pop_front();
+        idx = m_freeHead;
+        m_freeHead = m_slots[idx].nextFree;
+        m_slots[idx].nextFree = InvalidID;
+        if (m_freeHead == InvalidID)
+        {
+            m_freeTail = InvalidID;
+        }
+        m_freeCount--;
     }
     else
     {
-        m_generations.push_back(0);
-        idx = static_cast<Entity::ID>(m_generations.size() - 1);
+        XY_ASSERT(m_slots.size() <= MaxIndex, "Max entity index reached - increase XY_ENTITY_INDEX_BITS");
+        m_slots.emplace_back();
+        idx = static_cast<Entity::ID>(m_slots.size() - 1);
         
-        XY_ASSERT(idx < (1 << Detail::IndexBits), "Index out of range");
         if (idx >= m_componentMasks.size())
         {
             m_componentMasks.resize(m_componentMasks.size() + MinComponentMasks);
         }
     }
 
-    XY_ASSERT(idx < m_generations.size(), "Index out of range");
-    Entity e(idx, m_generations[idx]);
+    XY_ASSERT(idx < m_slots.size(), "Index out of range");
+    Entity e(idx, m_slots[idx].generation);
     e.m_entityManager = this;
 
     return e;
@@ -75,41 +88,68 @@ Entity EntityManager::createEntity()
 void EntityManager::destroyEntity(Entity entity)
 {
     const auto index = entity.getIndex();
-    XY_ASSERT(index < m_generations.size(), "Index out of range");
-    XY_ASSERT(m_generations[index] < 255, "Max generations reached!");
+    XY_ASSERT(index < m_slots.size(), "Index out of range");
 
-    ++m_generations[index];
-    m_freeIDs.push_back(index);
-    m_componentMasks[index].reset();
+    auto& slot = m_slots[index];
+    if (slot.generation != entity.getGeneration())
+    {
+        //already destroyed
+        return;
+    }
 
-    //this is a bit of a kludge because transform components
-    //need to be specifically reset to update the depth of any
-    //newly orphaned children. We *could* reset all components
-    //although this may just be unnecessary overhead.
-    auto& pool = getPool<xy::Transform>();
-    if (index < pool.size())
+    ++slot.generation;
+    if (slot.generation < MaxGeneration)
     {
-        pool[index] = /*std::move*/(xy::Transform());
+        //append to the free list
+        if (m_freeTail == InvalidID)
+        {
+            m_freeHead = index;
+        }
+        else
+        {
+            m_slots[m_freeTail].nextFree = index;
+        }
+        m_freeTail = index;
+        m_freeCount++;
     }
+    else
+    {
+        //retire the slot rather than wrapping the generation
+        //which would make stale handles appear valid again
+        LOG("Entity ID " + std::to_string(index) + " has reached its maximum generation and has been retired", xy::Logger::Type::Warning);
+    }
+
+    //remove the entity's components from their pools. This also
+    //destroys any Transform, so the depth of any newly orphaned
+    //children is correctly updated.
+    const auto& mask = m_componentMasks[index];
+    for (auto i = 0u; i < m_componentPools.size(); ++i)
+    {
+        if (mask.test(i) && m_componentPools[i])
+        {
+            m_componentPools[i]->remove(index);
+        }
+    }
+    m_componentMasks[index].reset();
 
     //let the world know the entity was destroyed
     auto msg = m_messageBus.post<Message::SceneEvent>(Message::SceneMessage);
-    msg->entityID = index;
+    msg->entityID = static_cast<sf::Int32>(index);
     msg->event = Message::SceneEvent::EntityDestroyed;
 }
 
 bool EntityManager::entityDestroyed(Entity entity) const
 {
     const auto id = entity.getIndex();
-    XY_ASSERT(id < m_generations.size(), "Generation index out of range");
+    XY_ASSERT(id < m_slots.size(), "Generation index out of range");
     
-    return (m_generations[id] != entity.getGeneration());
+    return (m_slots[id].generation != entity.getGeneration());
 }
 
 Entity EntityManager::getEntity(Entity::ID id) const
 {
-    XY_ASSERT(id < m_generations.size(), "Invalid Entity ID");
-    Entity ent(id, m_generations[id]);
+    XY_ASSERT(id < m_slots.size(), "Invalid Entity ID");
+    Entity ent(id, m_slots[id].generation);
     ent.m_entityManager = const_cast<EntityManager*>(this);
     return ent;
 }
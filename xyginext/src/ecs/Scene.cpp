@@ -30,6 +30,7 @@ source distribution.
 #include "xyginext/ecs/components/Camera.hpp"
 #include "xyginext/ecs/components/Transform.hpp"
 #include "xyginext/ecs/components/AudioListener.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
 
 #include <SFML/Window/Event.hpp>
 
@@ -58,7 +59,8 @@ namespace
 Scene::Scene(MessageBus& mb, std::size_t poolSize)
     : m_messageBus      (mb),
     m_entityManager     (mb, m_componentManager, poolSize),
-    m_systemManager     (*this, m_componentManager)
+    m_systemManager     (*this, m_componentManager, m_entityManager),
+    m_directorSubscribersDirty(false)
 {
     auto defaultCamera = createEntity();
     defaultCamera.addComponent<Transform>().setPosition(xy::DefaultSceneSize / 2.f);
@@ -123,6 +125,11 @@ Entity Scene::getEntity(Entity::ID id) const
     return m_entityManager.getEntity(id);
 }
 
+void Scene::setParallelProcessing(bool enabled)
+{
+    m_systemManager.setParallelProcessing(enabled);
+}
+
 void Scene::setPostEnabled(bool enabled)
 {
     if (enabled && !m_postEffects.empty())
@@ -131,7 +138,11 @@ void Scene::setPostEnabled(bool enabled)
         
         XY_ASSERT(App::getRenderWindow(), "no valid window");
         auto size = App::getRenderWindow()->getSize();
-        m_sceneBuffer.create(size.x, size.y, sf::ContextSettings(32));
+        if (!m_sceneBuffer)
+        {
+            m_sceneBuffer = std::make_unique<sf::RenderTexture>();
+        }
+        m_sceneBuffer->create(size.x, size.y, sf::ContextSettings(32));
         for (auto& p : m_postEffects) p->resizeBuffer(size.x, size.y);
     }
     else
@@ -192,9 +203,18 @@ void Scene::forwardEvent(const sf::Event& evt)
 void Scene::forwardMessage(const Message& msg)
 {
     m_systemManager.forwardMessage(msg);
-    for (auto& d : m_directors)
+
+    if (m_directorSubscribersDirty)
     {
-        d->handleMessage(msg);
+        buildDirectorSubscribers();
+    }
+
+    if (msg.id >= 0 && static_cast<std::size_t>(msg.id) < m_directorSubscribers.size())
+    {
+        for (auto* d : m_directorSubscribers[msg.id])
+        {
+            d->handleMessage(msg);
+        }
     }
 
     if (msg.id == Message::WindowMessage)
@@ -203,15 +223,15 @@ void Scene::forwardMessage(const Message& msg)
         if (data.type == Message::WindowEvent::Resized)
         {
             //update post effect buffers if they exist
-            if (m_sceneBuffer.getTexture().getNativeHandle() > 0)
+            if (m_sceneBuffer)
             {
-                m_sceneBuffer.create(data.width, data.height);
+                m_sceneBuffer->create(data.width, data.height);
 
                 for (auto& b : m_postBuffers)
                 {
-                    if (b.getTexture().getNativeHandle() > 0)
+                    if (b)
                     {
-                        b.create(data.width, data.height);
+                        b->create(data.width, data.height);
                     }
                 }
             }
@@ -223,25 +243,47 @@ void Scene::forwardMessage(const Message& msg)
 }
 
 //private
+void Scene::buildDirectorSubscribers()
+{
+    for (auto& subscribers : m_directorSubscribers)
+    {
+        subscribers.clear();
+    }
+
+    for (auto& d : m_directors)
+    {
+        for (auto id : d->m_subscriptions)
+        {
+            if (static_cast<std::size_t>(id) >= m_directorSubscribers.size())
+            {
+                m_directorSubscribers.resize(id + 1);
+            }
+            m_directorSubscribers[id].push_back(d.get());
+        }
+    }
+
+    m_directorSubscribersDirty = false;
+}
+
 void Scene::postRenderPath(sf::RenderTarget& rt, sf::RenderStates states)
 {
     auto activeView = getEntity(m_activeCamera).getComponent<Camera>().m_view;
 
-    m_sceneBuffer.setView(activeView);
+    m_sceneBuffer->setView(activeView);
 
-    m_sceneBuffer.clear();
+    m_sceneBuffer->clear();
     for (auto r : m_drawables)
     {
-        m_sceneBuffer.draw(*r, states);
+        m_sceneBuffer->draw(*r, states);
     }
-    m_sceneBuffer.display();
+    m_sceneBuffer->display();
 
-    sf::RenderTexture* inTex = &m_sceneBuffer;
+    sf::RenderTexture* inTex = m_sceneBuffer.get();
     sf::RenderTexture* outTex = nullptr;
 
     for (auto i = 0u; i < m_postEffects.size() - 1; ++i)
     {
-        outTex = &m_postBuffers[i % 2];
+        outTex = m_postBuffers[i % 2].get();
         outTex->clear();
         m_postEffects[i]->apply(*inTex, *outTex);
         outTex->display();
@@ -252,6 +294,11 @@ void Scene::postRenderPath(sf::RenderTarget& rt, sf::RenderStates states)
     m_postEffects.back()->apply(*inTex, rt);
 
     rt.setView(activeView);
+
+    //the scene buffer, each intermediate buffer and the final target
+    RenderStats stats;
+    stats.renderTargetChanges = m_postEffects.size() + 1;
+    RenderStats::addToFrame(stats);
 }
 
 void Scene::draw(sf::RenderTarget& rt, sf::RenderStates states) const
@@ -27,9 +27,17 @@ source distribution.
 
 #include "xyginext/ecs/System.hpp"
 
+#include <limits>
+#include <algorithm>
+
 using namespace xy;
 
-std::vector<Entity> System::getEntities() const
+namespace
+{
+    const std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+}
+
+const std::vector<Entity>& System::getEntities() const
 {
     return m_entities;
 }
@@ -37,22 +45,64 @@ std::vector<Entity> System::getEntities() const
 //public
 void System::addEntity(Entity entity)
 {
+    const auto index = entity.getIndex();
+    if (index >= m_entityIndices.size())
+    {
+        m_entityIndices.resize(index + 1, InvalidIndex);
+    }
+    m_entityIndices[index] = m_entities.size();
+
     m_entities.push_back(entity);
     onEntityAdded(entity);
 }
 
 void System::removeEntity(Entity entity)
 {
-    m_entities.erase(std::remove_if(std::begin(m_entities), std::end(m_entities),
-        [&entity, this](const Entity& e)
+    const auto index = entity.getIndex();
+    if (index >= m_entityIndices.size()
+        || m_entityIndices[index] == InvalidIndex)
+    {
+        return;
+    }
+
+    //derived systems may have reordered the list, eg by sorting it
+    if (m_entityIndices[index] >= m_entities.size()
+        || m_entities[m_entityIndices[index]].getIndex() != index)
+    {
+        rebuildEntityIndices();
+        if (m_entityIndices[index] == InvalidIndex)
+        {
+            return;
+        }
+    }
+
+    const auto position = m_entityIndices[index];
+    onEntityRemoved(m_entities[position]);
+
+    if (m_stableRemoval)
+    {
+        m_entities.erase(m_entities.begin() + position);
+        for (auto i = position; i < m_entities.size(); ++i)
+        {
+            m_entityIndices[m_entities[i].getIndex()] = i;
+        }
+    }
+    else
     {
-        if (entity == e)
+        if (position != m_entities.size() - 1)
         {
-            onEntityRemoved(e);
-            return true;
+            m_entities[position] = m_entities.back();
+            m_entityIndices[m_entities[position].getIndex()] = position;
         }
-        return false;
-    }), std::end(m_entities));
+        m_entities.pop_back();
+    }
+    m_entityIndices[index] = InvalidIndex;
+}
+
+bool System::hasEntity(Entity entity) const
+{
+    const auto index = entity.getIndex();
+    return index < m_entityIndices.size() && m_entityIndices[index] != InvalidIndex;
 }
 
 const ComponentMask& System::getComponentMask() const
@@ -65,6 +115,32 @@ void System::handleMessage(const Message&) {}
 void System::process(float) {}
 
 //protected
+void System::subscribe(Message::ID id)
+{
+    XY_ASSERT(id >= 0, "Invalid message ID");
+    if (std::find(m_subscriptions.begin(), m_subscriptions.end(), id) == m_subscriptions.end())
+    {
+        m_subscriptions.push_back(id);
+        if (m_systemManager)
+        {
+            m_systemManager->m_subscribersDirty = true;
+        }
+    }
+}
+
+void System::unsubscribe(Message::ID id)
+{
+    auto result = std::find(m_subscriptions.begin(), m_subscriptions.end(), id);
+    if (result != m_subscriptions.end())
+    {
+        m_subscriptions.erase(result);
+        if (m_systemManager)
+        {
+            m_systemManager->m_subscribersDirty = true;
+        }
+    }
+}
+
 void System::setScene(Scene& scene)
 {
     m_scene = &scene;
@@ -78,11 +154,35 @@ Scene* System::getScene()
 
 
 //private
-void System::processTypes(ComponentManager& cm)
+void System::processTypes(ComponentManager& cm, EntityManager& em)
 {
     for (const auto& componentType : m_pendingTypes)
     {
-        m_componentMask.set(cm.getFromTypeID(componentType));
+        const auto id = cm.getFromTypeID(componentType.type);
+        if (componentType.required)
+        {
+            m_componentMask.set(id);
+        }
+
+        if (componentType.access == ComponentAccess::Read)
+        {
+            m_readMask.set(id);
+        }
+        else
+        {
+            m_writeMask.set(id);
+        }
+
+        componentType.initPool(em);
     }
     m_pendingTypes.clear();
+}
+
+void System::rebuildEntityIndices()
+{
+    std::fill(m_entityIndices.begin(), m_entityIndices.end(), InvalidIndex);
+    for (auto i = 0u; i < m_entities.size(); ++i)
+    {
+        m_entityIndices[m_entities[i].getIndex()] = i;
+    }
 }
\ No newline at end of file
@@ -27,18 +27,45 @@ source distribution.
 
 #include "xyginext/ecs/Component.hpp"
 #include "xyginext/ecs/System.hpp"
+#include "xyginext/core/JobSystem.hpp"
+
+#include <algorithm>
 
 using namespace xy;
 
-SystemManager::SystemManager(Scene& scene, ComponentManager& cm) 
+namespace
+{
+    bool conflicts(const System* a, const System* b)
+    {
+        if (!a->isConcurrent() || !b->isConcurrent())
+        {
+            return true;
+        }
+
+        return (a->getWriteMask() & (b->getReadMask() | b->getWriteMask())).any()
+            || (b->getWriteMask() & a->getReadMask()).any();
+    }
+}
+
+SystemManager::SystemManager(Scene& scene, ComponentManager& cm, EntityManager& em) 
     : m_scene           (scene),
-    m_componentManager  (cm)
+    m_componentManager  (cm),
+    m_entityManager     (em),
+    m_parallelProcessing(true),
+    m_scheduleDirty     (true),
+    m_subscribersDirty  (false)
 {
     m_systems.reserve(128);
 }
 
 void SystemManager::addToSystems(Entity entity)
 {
+    const auto index = entity.getIndex();
+    if (index >= m_entitySystems.size())
+    {
+        m_entitySystems.resize(index + 1);
+    }
+
     const auto& entMask = entity.getComponentMask();
     for (auto& sys : m_systems)
     {
@@ -46,30 +73,125 @@ void SystemManager::addToSystems(Entity entity)
         if ((entMask & sysMask) == sysMask)
         {
             sys->addEntity(entity);
+            m_entitySystems[index].push_back(sys.get());
         }
     }
 }
 
 void SystemManager::removeFromSystems(Entity entity)
 {
-    for (auto& sys : m_systems)
+    const auto index = entity.getIndex();
+    if (index < m_entitySystems.size())
     {
-        sys->removeEntity(entity);
+        for (auto* sys : m_entitySystems[index])
+        {
+            sys->removeEntity(entity);
+        }
+        m_entitySystems[index].clear();
     }
 }
 
 void SystemManager::forwardMessage(const Message& msg)
 {
-    for (auto& sys : m_systems)
+    if (m_subscribersDirty)
     {
-        sys->handleMessage(msg);
+        buildSubscribers();
+    }
+
+    if (msg.id >= 0 && static_cast<std::size_t>(msg.id) < m_messageSubscribers.size())
+    {
+        for (auto* sys : m_messageSubscribers[msg.id])
+        {
+            sys->handleMessage(msg);
+        }
     }
 }
 
 void SystemManager::process(float dt)
 {
-    for (auto& system : m_activeSystems)
+    if (!m_parallelProcessing
+        || JobSystem::getWorkerCount() == 0)
+    {
+        for (auto& system : m_activeSystems)
+        {
+            system->process(dt);
+        }
+        return;
+    }
+
+    if (m_scheduleDirty)
+    {
+        buildSchedule();
+    }
+
+    for (const auto& group : m_schedule)
+    {
+        //systems are tagged with their type name so profilers can tell them apart
+        JobSystem::Counter counter;
+        for (auto i = 1u; i < group.size(); ++i)
+        {
+            auto* system = group[i];
+            JobSystem::schedule(system->getType().name(), [system, dt]() { system->process(dt); }, counter);
+        }
+        group[0]->process(dt);
+        JobSystem::wait(counter);
+    }
+}
+
+void SystemManager::setParallelProcessing(bool enabled)
+{
+    m_parallelProcessing = enabled;
+}
+
+//private
+void SystemManager::buildSchedule()
+{
+    //each system depends on all the systems added before it which it
+    //conflicts with, so its group is one after the latest of those.
+    //systems in the same group therefore never conflict with each other
+    std::vector<std::size_t> groupIndices(m_activeSystems.size());
+    m_schedule.clear();
+
+    for (auto i = 0u; i < m_activeSystems.size(); ++i)
     {
-        system->process(dt);
+        std::size_t group = 0;
+        for (auto j = 0u; j < i; ++j)
+        {
+            if (conflicts(m_activeSystems[i], m_activeSystems[j]))
+            {
+                group = std::max(group, groupIndices[j] + 1);
+            }
+        }
+        groupIndices[i] = group;
+
+        if (group == m_schedule.size())
+        {
+            m_schedule.emplace_back();
+        }
+        m_schedule[group].push_back(m_activeSystems[i]);
+    }
+
+    m_scheduleDirty = false;
+}
+
+void SystemManager::buildSubscribers()
+{
+    for (auto& subscribers : m_messageSubscribers)
+    {
+        subscribers.clear();
     }
+
+    for (auto& sys : m_systems)
+    {
+        for (auto id : sys->m_subscriptions)
+        {
+            if (static_cast<std::size_t>(id) >= m_messageSubscribers.size())
+            {
+                m_messageSubscribers.resize(id + 1);
+            }
+            m_messageSubscribers[id].push_back(sys.get());
+        }
+    }
+
+    m_subscribersDirty = false;
 }
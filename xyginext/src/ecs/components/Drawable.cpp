@@ -26,7 +26,6 @@ source distribution.
 *********************************************************************/
 
 #include "xyginext/ecs/components/Drawable.hpp"
-#include "xyginext/core/Log.hpp"
 #include "xyginext/core/Assert.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
@@ -37,15 +36,11 @@ source distribution.
 using namespace xy;
 
 Drawable::Drawable()
-    : m_textureCount    (0),
-    m_floatCount        (0),
-    m_vec2Count         (0),
-    m_vec3Count         (0),
-    m_boolCount         (0),
-    m_colourCount       (0),
-    m_matCount          (0),
-    m_currentTexCount   (0),
+    : m_boundsVersion   (0),
+    m_vertexVersion     (0),
+    m_material          (nullptr),
     m_cull              (true),
+    m_static            (false),
     m_croppingArea      (-std::numeric_limits<float>::max() / 2.f, -std::numeric_limits<float>::max() / 2.f,
                         std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
     m_cropped           (false)
@@ -54,15 +49,11 @@ Drawable::Drawable()
 }
 
 Drawable::Drawable(const sf::Texture& texture)
-    : m_textureCount    (0),
-    m_floatCount        (0),
-    m_vec2Count         (0),
-    m_vec3Count         (0),
-    m_boolCount         (0),
-    m_colourCount       (0),
-    m_matCount          (0),
-    m_currentTexCount   (0),
+    : m_boundsVersion   (0),
+    m_vertexVersion     (0),
+    m_material          (nullptr),
     m_cull              (true),
+    m_static            (false),
     m_croppingArea      (-std::numeric_limits<float>::max() / 2.f, -std::numeric_limits<float>::max() / 2.f,
                         std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
     m_cropped           (false)
@@ -78,198 +69,72 @@ void Drawable::setTexture(const sf::Texture* texture)
 void Drawable::setShader(sf::Shader* shader)
 {
     m_states.shader = shader;
-}
+    m_material = nullptr;
 
-void Drawable::setDepth(sf::Int32 depth)
-{
-    if (m_zDepth != depth)
+    if (m_uniformOverrides)
     {
-        m_zDepth = depth;
-        m_wantsSorting = true;
+        m_uniformOverrides->setShader(shader);
     }
 }
 
-void Drawable::bindUniform(const std::string& name, const sf::Texture& texture)
+void Drawable::setMaterial(const Material* material)
 {
-    if (m_textureCount < MaxBindings)
+    m_material = material;
+
+    if (material)
     {
-        auto result = std::find_if(m_textureBindings.begin(), m_textureBindings.end(),
-            [&name](const std::pair<std::string, const sf::Texture*>& pair)
-        {
-            return pair.first == name;
-        });
-        if (result == m_textureBindings.end())
-        {
-            m_textureBindings[m_textureCount] = std::make_pair(name, &texture);
-            m_textureCount++;
-        }
-        else
+        m_states.shader = material->getShader();
+
+        if (m_uniformOverrides)
         {
-            result->second = &texture;
+            m_uniformOverrides->setShader(material->getShader());
         }
     }
-    else
-    {
-        Logger::log(name + ": uniform not bound, MaxBindings reached", xy::Logger::Type::Info);
-    }
+}
+
+void Drawable::setDepth(sf::Int32 depth)
+{
+    m_zDepth = depth;
+}
+
+void Drawable::bindUniform(const std::string& name, const sf::Texture& texture)
+{
+    getUniformOverrides().setUniform(name, texture);
 }
 
 void Drawable::bindUniform(const std::string& name, float value)
 {
-    if (m_floatCount < MaxBindings)
-    {
-        auto result = std::find_if(m_floatBindings.begin(), m_floatBindings.end(),
-            [&name](const std::pair<std::string, float>& pair)
-        {
-            return pair.first == name;
-        });
-        if (result == m_floatBindings.end())
-        {
-            m_floatBindings[m_floatCount] = std::make_pair(name, value);
-            m_floatCount++;
-        }
-        else
-        {
-            result->second = value;
-        }
-    }
-    else
-    {
-        Logger::log(name + ": uniform not bound, MaxBindings reached", xy::Logger::Type::Info);
-    }
+    getUniformOverrides().setUniform(name, value);
 }
 
 void Drawable::bindUniform(const std::string& name, sf::Vector2f value)
 {
-    if (m_vec2Count < MaxBindings)
-    {
-        auto result = std::find_if(m_vec2Bindings.begin(), m_vec2Bindings.end(),
-            [&name](const std::pair<std::string, sf::Vector2f>& pair)
-        {
-            return pair.first == name;
-        });
-        if (result == m_vec2Bindings.end())
-        {
-            m_vec2Bindings[m_vec2Count] = std::make_pair(name, value);
-            m_vec2Count++;
-        }
-        else
-        {
-            result->second = value;
-        }
-    }
-    else
-    {
-        Logger::log(name + ": uniform not bound, MaxBindings reached", xy::Logger::Type::Info);
-    }
+    getUniformOverrides().setUniform(name, value);
 }
 
 void Drawable::bindUniform(const std::string& name, sf::Vector3f value)
 {
-    if (m_vec3Count < MaxBindings)
-    {
-        auto result = std::find_if(m_vec3Bindings.begin(), m_vec3Bindings.end(),
-            [&name](const std::pair<std::string, sf::Vector3f>& pair)
-        {
-            return pair.first == name;
-        });
-        if (result == m_vec3Bindings.end())
-        {
-            m_vec3Bindings[m_vec3Count] = std::make_pair(name, value);
-            m_vec3Count++;
-        }
-        else
-        {
-            result->second = value;
-        }
-    }
-    else
-    {
-        Logger::log(name + ": uniform not bound, MaxBindings reached", xy::Logger::Type::Info);
-    }
+    getUniformOverrides().setUniform(name, value);
 }
 
 void Drawable::bindUniform(const std::string& name, bool value)
 {
-    if (m_boolCount < MaxBindings)
-    {
-        auto result = std::find_if(m_boolBindings.begin(), m_boolBindings.end(),
-            [&name](const std::pair<std::string, bool>& pair)
-        {
-            return pair.first == name;
-        });
-        if (result == m_boolBindings.end())
-        {
-            m_boolBindings[m_boolCount] = std::make_pair(name, value);
-            m_boolCount++;
-        }
-        else
-        {
-            result->second = value;
-        }
-    }
-    else
-    {
-        Logger::log(name + ": uniform not bound, MaxBindings reached", xy::Logger::Type::Info);
-    }
+    getUniformOverrides().setUniform(name, value);
 }
 
 void Drawable::bindUniform(const std::string& name, sf::Color value)
 {
-    if (m_colourCount < MaxBindings)
-    {
-        auto result = std::find_if(m_colourBindings.begin(), m_colourBindings.end(),
-            [&name](const std::pair<std::string, sf::Glsl::Vec4>& pair)
-        {
-            return pair.first == name;
-        });
-        if (result == m_colourBindings.end())
-        {
-            m_colourBindings[m_colourCount] = std::make_pair(name, value);
-            m_colourCount++;
-        }
-        else
-        {
-            result->second = value;
-        }
-    }
-    else
-    {
-        Logger::log(name + ": uniform not bound, MaxBindings reached", xy::Logger::Type::Info);
-    }
+    getUniformOverrides().setUniform(name, value);
 }
 
 void Drawable::bindUniform(const std::string& name, const float* matrix)
 {
-    if (m_matCount < MaxBindings)
-    {
-        auto result = std::find_if(m_matBindings.begin(), m_matBindings.end(),
-            [&name](const std::pair<std::string, const float*>& pair)
-        {
-            return pair.first == name;
-        });
-        if (result == m_matBindings.end())
-        {
-            m_matBindings[m_matCount] = std::make_pair(name, matrix);
-            m_matCount++;
-        }
-        else
-        {
-            result->second = matrix;
-        }
-    }
+    getUniformOverrides().setUniform(name, matrix);
 }
 
 void Drawable::bindUniformToCurrentTexture(const std::string& name)
 {
-    if (m_currentTexCount < MaxBindings)
-    {
-        auto result = std::find(m_currentTexBindings.begin(), m_currentTexBindings.end(), name);
-        if (result == m_currentTexBindings.end())
-        {
-            m_currentTexBindings[m_currentTexCount++] = name;
-        }
-    }
+    getUniformOverrides().setUniformToCurrentTexture(name);
 }
 
 void Drawable::setBlendMode(sf::BlendMode mode)
@@ -299,6 +164,9 @@ sf::FloatRect Drawable::getLocalBounds() const
 
 void Drawable::updateLocalBounds()
 {
+    m_vertexVersion++;
+    const auto oldBounds = m_localBounds;
+
     m_localBounds.left = std::numeric_limits<float>::max();
     m_localBounds.top = std::numeric_limits<float>::max();
     m_localBounds.width = 0.f;
@@ -324,11 +192,21 @@ void Drawable::updateLocalBounds()
             m_localBounds.height = v.position.y - m_localBounds.top;
         }
     }
+
+    if (m_localBounds != oldBounds)
+    {
+        m_boundsVersion++;
+    }
 }
 
 void Drawable::updateLocalBounds(sf::FloatRect rect)
 {
-    m_localBounds = rect;
+    m_vertexVersion++;
+    if (rect != m_localBounds)
+    {
+        m_localBounds = rect;
+        m_boundsVersion++;
+    }
 }
 
 sf::RenderStates Drawable::getStates() const
@@ -340,49 +218,28 @@ void Drawable::applyShader() const
 {
     XY_ASSERT(m_states.shader, "No shader set!");
 
-    sf::Shader* shader = const_cast<sf::Shader*>(m_states.shader);
-    for (auto i = 0u; i < m_textureCount; ++i)
-    {
-        const auto& [name, value] = m_textureBindings[i];
-        shader->setUniform(name, *value);
-    }
-    for (auto i = 0u; i < m_floatCount; ++i)
-    {
-        const auto&[name, value] = m_floatBindings[i];
-        shader->setUniform(name, value);
-    }
-    for (auto i = 0u; i < m_vec2Count; ++i)
+    if (m_material && !m_material->empty())
     {
-        const auto&[name, value] = m_vec2Bindings[i];
-        shader->setUniform(name, value);
+        m_material->apply();
     }
-    for (auto i = 0u; i < m_vec3Count; ++i)
-    {
-        const auto&[name, value] = m_vec3Bindings[i];
-        shader->setUniform(name, value);
-    }
-    for (auto i = 0u; i < m_boolCount; ++i)
-    {
-        const auto&[name, value] = m_boolBindings[i];
-        shader->setUniform(name, value);
-    }
-    for (auto i = 0u; i < m_colourCount; ++i)
-    {
-        const auto&[name, value] = m_colourBindings[i];
-        shader->setUniform(name, value);
-    }
-    for (auto i = 0u; i < m_matCount; ++i)
+
+    if (hasUniformBindings())
     {
-        const auto&[name, value] = m_matBindings[i];
-        shader->setUniform(name, sf::Glsl::Mat4(value));
+        m_uniformOverrides->apply();
     }
-    for (auto i = 0u; i < m_currentTexCount; ++i)
+}
+
+//private
+Material& Drawable::getUniformOverrides()
+{
+    if (!m_uniformOverrides)
     {
-        shader->setUniform(m_currentTexBindings[i], sf::Shader::CurrentTexture);
+        m_uniformOverrides.emplace();
+        m_uniformOverrides->setShader(const_cast<sf::Shader*>(m_states.shader));
     }
+    return *m_uniformOverrides;
 }
 
-//private
 void Drawable::draw(sf::RenderTarget& rt, sf::RenderStates states) const
 {
     rt.draw(m_vertices.data(), m_vertices.size(), m_primitiveType, states);
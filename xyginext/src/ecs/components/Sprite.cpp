@@ -34,8 +34,7 @@ using namespace xy;
 Sprite::Sprite()
     : m_texture     (nullptr),
     m_colour        (sf::Color::White),
-    m_dirty         (true),
-    m_animationCount(0)
+    m_dirty         (true)
 {
 
 }
@@ -43,8 +42,7 @@ Sprite::Sprite()
 Sprite::Sprite(const sf::Texture& texture)
     : m_texture     (nullptr),
     m_colour        (sf::Color::White),
-    m_dirty         (true),
-    m_animationCount(0)
+    m_dirty         (true)
 {
     setTexture(texture);
 }
@@ -52,8 +50,7 @@ Sprite::Sprite(const sf::Texture& texture)
 /*Sprite::Sprite(const ResourceHandle& texture)
 : m_texture     (nullptr),
 m_colour        (sf::Color::White),
-m_dirty         (true),
-m_animationCount(0)
+m_dirty         (true)
 {
     setTexture(texture);
 }*/
@@ -95,3 +92,9 @@ sf::Color Sprite::getColour() const
 {
     return m_colour;
 }
+
+const std::vector<Sprite::Animation>& Sprite::getAnimations() const
+{
+    static const std::vector<Animation> empty;
+    return m_animations ? m_animations->getAnimations() : empty;
+}
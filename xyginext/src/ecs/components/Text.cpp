@@ -35,6 +35,8 @@ source distribution.
 
 #include "xyginext/core/Log.hpp"
 
+#include "../../detail/GlyphRunCache.hpp"
+
 using namespace xy;
 
 Text::Text()
@@ -207,127 +209,57 @@ void Text::setAlignment(Text::Alignment alignment)
     m_dirty = true;
 }
 
+void Text::clearGlyphCache()
+{
+    Detail::GlyphRunCache::clear();
+}
+
+Text::LayoutStats Text::getLayoutStats()
+{
+    LayoutStats stats;
+    stats.glyphLookups = Detail::GlyphRunCache::getGlyphLookupCount();
+    stats.kerningLookups = Detail::GlyphRunCache::getKerningLookupCount();
+    stats.cachedLayouts = Detail::GlyphRunCache::size();
+    return stats;
+}
+
 //private
 void Text::updateVertices(Drawable& drawable)
 {
     m_dirty = false;
-    
+
+    Detail::GlyphRunParams params;
+    params.font = m_font;
+    params.charSize = m_charSize;
+    params.outlineThickness = m_outlineThickness;
+    params.verticalSpacing = m_verticalSpacing;
+    m_glyphRun = Detail::GlyphRunCache::get(params, m_string, std::move(m_glyphRun));
+
     auto& vertices = drawable.getVertices();
+    vertices = m_glyphRun->vertices;
+    sf::FloatRect localBounds = m_glyphRun->bounds;
 
-    vertices.clear();
-    sf::FloatRect localBounds;
-    
-    //skip if nothing to build
-    if (!m_font || m_string.isEmpty())
-    {
-        drawable.updateLocalBounds(localBounds);
-        return;
-    }
-    
-    //update glyphs - TODO here we could check for bold fonts in the future
-    float xOffset = static_cast<float>(m_font->getGlyph(L' ', m_charSize, false).advance);
-    float yOffset = static_cast<float>(m_font->getLineSpacing(m_charSize));
-    float x = 0.f;
-    float y = static_cast<float>(m_charSize);
-    
-    float minX = x;
-    float minY = y;
-    float maxX = 0.f;
-    float maxY = 0.f;
-    
-    sf::Uint32 prevChar = 0;
-    const auto& string = m_string;
-    for (auto i = 0u; i < string.getSize(); ++i)
+    //runs are white, apply the colours a quad at a time
+    const std::size_t quadSize = 6;
+    for (auto i = 0u; i < vertices.size(); i += quadSize)
     {
-        sf::Uint32 currChar = string[i];
-        
-        x += m_font->getKerning(prevChar, currChar, m_charSize);
-        prevChar = currChar;
-        
-        //whitespace chars
-        if (currChar == ' ' || currChar == '\t' || currChar == '\n')
+        auto colour = m_fillColour;
+        if (m_outlineThickness != 0)
         {
-            minX = std::min(minX, x);
-            minY = std::min(minY, y);
-            
-            switch (currChar)
+            bool outlineFirst = m_outlineThickness > 0;
+            bool firstQuad = ((i / quadSize) % 2) == 0;
+            if (outlineFirst == firstQuad)
             {
-                default: break;
-                case ' ':
-                    x += xOffset;
-                    break;
-                case '\t':
-                    x += xOffset * 4.f; //4 spaces for tab suckas
-                    break;
-                case '\n':
-                    y += yOffset + m_verticalSpacing;
-                    x = 0.f;
-                    break;
+                colour = m_outlineColour;
             }
-            
-            maxX = std::max(maxX, x);
-            maxY = std::max(maxY, y);
-            
-            continue; //skip quad for whitespace
         }
-        
-        //create the quads.
-        auto addOutline = [&]()
-        {
-            const auto& glyph = m_font->getGlyph(currChar, m_charSize, false, m_outlineThickness);
-
-            float left = glyph.bounds.left;
-            float top = glyph.bounds.top;
-            float right = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.top + glyph.bounds.height;
-
-            //add the outline glyph to the vertices
-            addQuad(vertices, sf::Vector2f(x, y), m_outlineColour, glyph, m_outlineThickness);
 
-            minX = std::min(minX, x + left - m_outlineThickness);
-            maxX = std::max(maxX, x + right - m_outlineThickness);
-            minY = std::min(minY, y + top - m_outlineThickness);
-            maxY = std::max(maxY, y + bottom - m_outlineThickness);
-        };
-
-        //if outline is larger, add first
-        if (m_outlineThickness > 0)
-        {
-            addOutline();
-        }
-
-        const auto& glyph = m_font->getGlyph(currChar, m_charSize, false);
-        addQuad(vertices, sf::Vector2f(x, y), m_fillColour, glyph);
-        
-        //else add outline on top
-        if (m_outlineThickness < 0)
-        {
-            addOutline();
-        }
-
-        //only do this if not outlined
-        if (m_outlineThickness == 0)
+        for (auto j = i; j < i + quadSize; ++j)
         {
-            float left = glyph.bounds.left;
-            float top = glyph.bounds.top;
-            float right = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.top + glyph.bounds.height;
-
-            minX = std::min(minX, x + left);
-            maxX = std::max(maxX, x + right);
-            minY = std::min(minY, y + top);
-            maxY = std::max(maxY, y + bottom);
+            vertices[j].color = colour;
         }
-
-        x += glyph.advance;
     }
-    
-    localBounds.left = minX;
-    localBounds.top = minY;
-    localBounds.width = maxX - minX;
-    localBounds.height = maxY - minY;
-    
-    
+
     //check for alignment
     float offset = 0.f;
     if (m_alignment == Text::Alignment::Centre)
@@ -349,24 +281,3 @@ void Text::updateVertices(Drawable& drawable)
 
     drawable.updateLocalBounds(localBounds);
 }
-
-void Text::addQuad(std::vector<sf::Vertex>& vertices, sf::Vector2f position, sf::Color colour, const sf::Glyph& glyph,  float outlineThickness)
-{
-    float left = glyph.bounds.left;
-    float top = glyph.bounds.top;
-    float right = glyph.bounds.left + glyph.bounds.width;
-    float bottom = glyph.bounds.top + glyph.bounds.height;
-    
-    float u1 = static_cast<float>(glyph.textureRect.left);
-    float v1 = static_cast<float>(glyph.textureRect.top);
-    float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
-    float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height);
-    
-    vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left - outlineThickness, position.y + top - outlineThickness), colour, sf::Vector2f(u1, v1)));
-    vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - outlineThickness, position.y + top - outlineThickness), colour, sf::Vector2f(u2, v1)));
-    vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left - outlineThickness, position.y + bottom - outlineThickness), colour, sf::Vector2f(u1, v2)));
-    vertices.push_back(sf::Vertex(sf::Vector2f(position.x + left - outlineThickness, position.y + bottom - outlineThickness), colour, sf::Vector2f(u1, v2)));
-    vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - outlineThickness, position.y + top - outlineThickness), colour, sf::Vector2f(u2, v1)));
-    vertices.push_back(sf::Vertex(sf::Vector2f(position.x + right - outlineThickness, position.y + bottom - outlineThickness), colour, sf::Vector2f(u2, v2)));
-}
-
@@ -0,0 +1,174 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include "xyginext/ecs/components/TileMapLayer.hpp"
+#include "xyginext/core/Assert.hpp"
+
+#include <algorithm>
+
+using namespace xy;
+
+TileMapLayer::TileMapLayer()
+    : m_animationStamp  (0),
+    m_chunkSize         (DefaultChunkSize),
+    m_colour            (sf::Color::White)
+{
+
+}
+
+//public
+void TileMapLayer::create(sf::Vector2u tileCount, sf::Vector2f tileSize, std::vector<Tile> tiles)
+{
+    XY_ASSERT(tiles.empty() || tiles.size() == tileCount.x * tileCount.y, "Incorrect number of tiles");
+
+    m_tileCount = tileCount;
+    m_tileSize = tileSize;
+    m_tiles = std::move(tiles);
+    m_tiles.resize(tileCount.x * tileCount.y);
+
+    m_maxTileSize.x = std::max(m_maxTileSize.x, tileSize.x);
+    m_maxTileSize.y = std::max(m_maxTileSize.y, tileSize.y);
+
+    resetChunks();
+}
+
+void TileMapLayer::addTileset(const sf::Texture& texture, sf::Uint32 firstID, sf::Uint32 tileCount, sf::Uint32 columns,
+                              sf::Vector2u tileSize, sf::Uint32 margin, sf::Uint32 spacing)
+{
+    XY_ASSERT(firstID > 0, "Tile ID 0 is reserved for empty tiles");
+    XY_ASSERT(columns > 0, "Tileset must have at least one column");
+
+    Tileset tileset;
+    tileset.texture = &texture;
+    tileset.firstID = firstID;
+    tileset.tileCount = tileCount;
+    tileset.columns = columns;
+    tileset.tileSize = tileSize;
+    tileset.margin = margin;
+    tileset.spacing = spacing;
+
+    auto result = std::upper_bound(m_tilesets.begin(), m_tilesets.end(), firstID,
+        [](sf::Uint32 id, const Tileset& ts) {return id < ts.firstID; });
+    m_tilesets.insert(result, tileset);
+
+    m_maxTileSize.x = std::max(m_maxTileSize.x, static_cast<float>(tileSize.x));
+    m_maxTileSize.y = std::max(m_maxTileSize.y, static_cast<float>(tileSize.y));
+
+    //array indices stored in the chunks are no longer valid
+    markAllDirty();
+}
+
+void TileMapLayer::addAnimation(sf::Uint32 id, std::vector<Frame> frames)
+{
+    if (frames.empty())
+    {
+        return;
+    }
+
+    Animation anim;
+    anim.frames = std::move(frames);
+
+    if (auto result = m_animationLookup.find(id); result != m_animationLookup.end())
+    {
+        m_animations[result->second] = std::move(anim);
+    }
+    else
+    {
+        m_animationLookup.insert(std::make_pair(id, m_animations.size()));
+        m_animations.push_back(std::move(anim));
+    }
+    markAllDirty();
+}
+
+void TileMapLayer::setTile(sf::Vector2u position, Tile tile)
+{
+    XY_ASSERT(position.x < m_tileCount.x && position.y < m_tileCount.y, "Tile position out of range");
+
+    m_tiles[position.y * m_tileCount.x + position.x] = tile;
+
+    auto chunkX = position.x / m_chunkSize;
+    auto chunkY = position.y / m_chunkSize;
+    m_chunks[chunkY * m_chunkCount.x + chunkX].dirty = true;
+}
+
+TileMapLayer::Tile TileMapLayer::getTile(sf::Vector2u position) const
+{
+    XY_ASSERT(position.x < m_tileCount.x && position.y < m_tileCount.y, "Tile position out of range");
+    return m_tiles[position.y * m_tileCount.x + position.x];
+}
+
+void TileMapLayer::setChunkSize(sf::Uint32 size)
+{
+    XY_ASSERT(size > 0, "Chunk size must be greater than zero");
+    m_chunkSize = size;
+    resetChunks();
+}
+
+void TileMapLayer::setOffset(sf::Vector2f offset)
+{
+    m_offset = offset;
+    markAllDirty();
+}
+
+void TileMapLayer::setColour(sf::Color colour)
+{
+    m_colour = colour;
+    for (auto& chunk : m_chunks)
+    {
+        for (auto& array : chunk.vertices)
+        {
+            for (auto& vertex : array)
+            {
+                vertex.color = colour;
+            }
+        }
+    }
+}
+
+sf::FloatRect TileMapLayer::getLocalBounds() const
+{
+    return { m_offset.x, m_offset.y, m_tileCount.x * m_tileSize.x, m_tileCount.y * m_tileSize.y };
+}
+
+//private
+void TileMapLayer::resetChunks()
+{
+    m_chunkCount.x = (m_tileCount.x + m_chunkSize - 1) / m_chunkSize;
+    m_chunkCount.y = (m_tileCount.y + m_chunkSize - 1) / m_chunkSize;
+
+    m_chunks.clear();
+    m_chunks.resize(m_chunkCount.x * m_chunkCount.y);
+}
+
+void TileMapLayer::markAllDirty()
+{
+    for (auto& chunk : m_chunks)
+    {
+        chunk.dirty = true;
+    }
+}
@@ -28,17 +28,53 @@ source distribution.
 #include "xyginext/ecs/components/Transform.hpp"
 #include "xyginext/core/Assert.hpp"
 
+#include <cmath>
+
 using namespace xy;
 
+namespace
+{
+    std::atomic<sf::Uint32> hierarchyVersion(0);
+
+    //sf::Transformable::getTransform() lazily updates its cached matrix,
+    //which isn't safe when reading from multiple threads, so the local
+    //transform is calculated here from the transformable's properties instead
+    sf::Transform calcLocalTransform(const sf::Transformable& tx)
+    {
+        const float angle = -tx.getRotation() * 3.141592654f / 180.f;
+        const float cosine = std::cos(angle);
+        const float sine = std::sin(angle);
+
+        const auto& scale = tx.getScale();
+        const auto& origin = tx.getOrigin();
+        const auto& position = tx.getPosition();
+
+        const float sxc = scale.x * cosine;
+        const float syc = scale.y * cosine;
+        const float sxs = scale.x * sine;
+        const float sys = scale.y * sine;
+        const float x = -origin.x * sxc - origin.y * sys + position.x;
+        const float y = origin.x * sxs - origin.y * syc + position.y;
+
+        return { sxc, sys, x,
+                -sxs, syc, y,
+                0.f, 0.f, 1.f };
+    }
+}
+
 Transform::Transform()
     : m_parent      (nullptr),
-    m_depth         (0)
+    m_depth         (0),
+    m_worldState    (Dirty),
+    m_version       (0)
 {
 
 }
 
 Transform::~Transform()
 {
+    hierarchyVersion.fetch_add(1, std::memory_order_relaxed);
+
     //remove this transform from its parent
     if (m_parent)
     {
@@ -60,7 +96,9 @@ Transform::~Transform()
 
 Transform::Transform(Transform&& other)
     : m_parent      (nullptr),
-    m_depth         (0)
+    m_depth         (0),
+    m_worldState    (Dirty),
+    m_version       (other.m_version.load(std::memory_order_relaxed) + 1)
 {
     if (other.m_parent != this)
     {
@@ -129,6 +167,7 @@ Transform& Transform::operator=(Transform&& other)
     if (&other != this && other.m_parent != this)
     {
         //LOG("Moved tx via assignment", xy::Logger::Type::Info);
+        m_version.fetch_add(1, std::memory_order_relaxed);
 
         //orphan any children
         for (auto c : m_children)
@@ -185,6 +224,78 @@ Transform& Transform::operator=(Transform&& other)
 }
 
 //public
+void Transform::setPosition(float x, float y)
+{
+    sf::Transformable::setPosition(x, y);
+    markDirty();
+}
+
+void Transform::setPosition(const sf::Vector2f& position)
+{
+    sf::Transformable::setPosition(position);
+    markDirty();
+}
+
+void Transform::setRotation(float angle)
+{
+    sf::Transformable::setRotation(angle);
+    markDirty();
+}
+
+void Transform::setScale(float x, float y)
+{
+    sf::Transformable::setScale(x, y);
+    markDirty();
+}
+
+void Transform::setScale(const sf::Vector2f& scale)
+{
+    sf::Transformable::setScale(scale);
+    markDirty();
+}
+
+void Transform::setOrigin(float x, float y)
+{
+    sf::Transformable::setOrigin(x, y);
+    markDirty();
+}
+
+void Transform::setOrigin(const sf::Vector2f& origin)
+{
+    sf::Transformable::setOrigin(origin);
+    markDirty();
+}
+
+void Transform::move(float x, float y)
+{
+    sf::Transformable::move(x, y);
+    markDirty();
+}
+
+void Transform::move(const sf::Vector2f& offset)
+{
+    sf::Transformable::move(offset);
+    markDirty();
+}
+
+void Transform::rotate(float angle)
+{
+    sf::Transformable::rotate(angle);
+    markDirty();
+}
+
+void Transform::scale(float x, float y)
+{
+    sf::Transformable::scale(x, y);
+    markDirty();
+}
+
+void Transform::scale(const sf::Vector2f& factor)
+{
+    sf::Transformable::scale(factor);
+    markDirty();
+}
+
 void Transform::addChild(Transform& child)
 {
     XY_ASSERT(this != &child, "Can't parent to ourself!");
@@ -232,11 +343,31 @@ void Transform::removeChild(Transform& tx)
 
 sf::Transform Transform::getWorldTransform() const
 {
+    if (m_worldState.load(std::memory_order_acquire) == Clean)
+    {
+        return m_worldTransform;
+    }
+
+    auto worldTransform = calcLocalTransform(*this);
+    bool parentClean = true;
     if (m_parent)
     {
-        return m_parent->getWorldTransform() * getTransform();
+        worldTransform = m_parent->getWorldTransform() * worldTransform;
+
+        //only cache the result if the parent did too, so that a clean
+        //transform never has a dirty parent (see markDirty())
+        parentClean = (m_parent->m_worldState.load(std::memory_order_acquire) == Clean);
+    }
+
+    //if another thread is already updating the cache just return our own result
+    sf::Uint8 expected = Dirty;
+    if (parentClean
+        && m_worldState.compare_exchange_strong(expected, Updating, std::memory_order_acquire))
+    {
+        m_worldTransform = worldTransform;
+        m_worldState.store(Clean, std::memory_order_release);
     }
-    return getTransform();
+    return worldTransform;
 }
 
 sf::Vector2f Transform::getWorldPosition() const
@@ -256,7 +387,11 @@ float Transform::getWorldRotation() const
 //private
 void Transform::setDepth(std::size_t depth)
 {
+    //depth changes when we're reparented so the world transform is also invalid
     m_depth = depth;
+    m_worldState.store(Dirty, std::memory_order_relaxed);
+    m_version.fetch_add(1, std::memory_order_relaxed);
+    hierarchyVersion.fetch_add(1, std::memory_order_relaxed);
     for (auto& c : m_children)
     {
         c->setDepth(depth + 1);
@@ -264,3 +399,33 @@ void Transform::setDepth(std::size_t depth)
 
     XY_ASSERT(m_depth < 250, "Transform added with depth " + std::to_string(m_depth));
 }
+
+sf::Uint32 Transform::getHierarchyVersion()
+{
+    return hierarchyVersion.load(std::memory_order_relaxed);
+}
+
+bool Transform::worldTransformChanged(sf::Uint32& version) const
+{
+    //a transform which isn't clean may have been modified since it
+    //was last read, even if it was already dirty at the time
+    const auto current = m_version.load(std::memory_order_relaxed);
+    const bool changed = (current != version)
+        || (m_worldState.load(std::memory_order_acquire) != Clean);
+    version = current;
+    return changed;
+}
+
+void Transform::markDirty()
+{
+    //children are always dirty if we are, so there's no need to visit them again
+    if (m_worldState.load(std::memory_order_relaxed) != Dirty)
+    {
+        m_worldState.store(Dirty, std::memory_order_relaxed);
+        m_version.fetch_add(1, std::memory_order_relaxed);
+        for (auto c : m_children)
+        {
+            c->markDirty();
+        }
+    }
+}
@@ -42,8 +42,13 @@ using namespace xy;
 AudioSystem::AudioSystem(MessageBus& mb)
     : System(mb, typeid(AudioSystem))
 {
+    subscribe(Message::AudioMessage);
+
     requireComponent<AudioEmitter>();
-    requireComponent<Transform>();
+    requireComponent<Transform>(ComponentAccess::Read);
+    useComponent<AudioListener>(ComponentAccess::Read);
+
+    setConcurrent(true);
 }
 
 //public
@@ -54,11 +59,10 @@ void AudioSystem::handleMessage(const xy::Message& msg)
         const auto& data = msg.getData<Message::AudioEvent>();
         if (data.type == Message::AudioEvent::ChannelVolumeChanged)
         {
-            auto& entities = getEntities();
-            for (auto entity : entities)
+            each<AudioEmitter>([](Entity, AudioEmitter& emitter)
             {
-                entity.getComponent<AudioEmitter>().applyMixerSettings();
-            }
+                emitter.applyMixerSettings();
+            });
         }
     }
 }
@@ -73,18 +77,14 @@ void AudioSystem::process(float)
     sf::Listener::setPosition({ listenerPos.x, listenerPos.y, listener.m_depth });
     sf::Listener::setGlobalVolume(listener.m_volume * AudioMixer::getMasterVolume() * 100.f);
 
-    auto& entities = getEntities();
-    for (auto& entity : entities)
+    each<Transform, AudioEmitter>([](Entity, const Transform& tx, AudioEmitter& audio)
     {
         //update position of entities
-        const auto& tx = entity.getComponent<xy::Transform>();
-        auto& audio = entity.getComponent<xy::AudioEmitter>();
-
         auto pos = tx.getWorldTransform().transformPoint({});
         audio.setPosition({ pos.x, pos.y, 0.f });
         audio.applyMixerSettings();
         audio.update();
-    }
+    });
 }
 
 //private
@@ -28,23 +28,211 @@ source distribution.
 #include "xyginext/ecs/systems/CallbackSystem.hpp"
 #include "xyginext/ecs/components/Callback.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using namespace xy;
 
+namespace
+{
+    const float TickLength = 1.f / 60.f;
+    const std::size_t NotAwake = std::numeric_limits<std::size_t>::max();
+}
+
 CallbackSystem::CallbackSystem(MessageBus& mb)
-    : System(mb, typeid(CallbackSystem))
+    : System            (mb, typeid(CallbackSystem)),
+    m_currentTick       (0),
+    m_tickAccumulator   (0.f)
 {
     requireComponent<Callback>();
 }
 
+//public
 void CallbackSystem::process(float dt)
 {
-    auto& entities = getEntities();
-    for (auto& entity : entities)
+    m_tickAccumulator += dt;
+    while (m_tickAccumulator >= TickLength)
+    {
+        m_tickAccumulator -= TickLength;
+        advance();
+    }
+
+    for (auto i = 0u; i < m_awakeEntities.size();)
     {
+        auto entity = m_awakeEntities[i];
         auto& cb = entity.getComponent<Callback>();
-        if (cb.active)
+
+        if (cb.m_sleepRequest == Callback::SleepRequest::None
+            && cb.active)
         {
             cb.function(entity, dt);
         }
+
+        //sleeping removes the entity from the awake list, moving the last entity to this index
+        if (cb.m_sleepRequest != Callback::SleepRequest::None)
+        {
+            sleep(entity, cb);
+            if (cb.m_sleeping)
+            {
+                continue;
+            }
+        }
+        i++;
+    }
+}
+
+float CallbackSystem::getTime() const
+{
+    return static_cast<float>(m_currentTick) * TickLength + m_tickAccumulator;
+}
+
+void CallbackSystem::wake(Entity entity)
+{
+    const auto index = entity.getIndex();
+    if (index < m_awakeIndices.size()
+        && m_awakeIndices[index] == NotAwake
+        && hasEntity(entity))
+    {
+        auto& cb = entity.getComponent<Callback>();
+        cb.m_sleeping = false;
+        cb.m_sleepRequest = Callback::SleepRequest::None;
+
+        m_sleepStamps[index]++;
+        addAwake(entity);
+    }
+}
+
+//private
+void CallbackSystem::sleep(Entity entity, Callback& cb)
+{
+    const float wakeTime = (cb.m_sleepRequest == Callback::SleepRequest::For) ? getTime() + cb.m_sleepTime : cb.m_sleepTime;
+    cb.m_sleepRequest = Callback::SleepRequest::None;
+
+    const auto wakeTick = static_cast<std::uint64_t>(std::max(0.f, std::ceil(wakeTime / TickLength)));
+    if (wakeTick <= m_currentTick)
+    {
+        return;
+    }
+
+    cb.m_sleeping = true;
+    removeAwake(entity);
+
+    SleepEntry entry;
+    entry.entity = entity;
+    entry.wakeTick = wakeTick;
+    entry.stamp = ++m_sleepStamps[entity.getIndex()];
+    insert(entry);
+}
+
+void CallbackSystem::addAwake(Entity entity)
+{
+    m_awakeIndices[entity.getIndex()] = m_awakeEntities.size();
+    m_awakeEntities.push_back(entity);
+}
+
+void CallbackSystem::removeAwake(Entity entity)
+{
+    auto& position = m_awakeIndices[entity.getIndex()];
+    if (position != NotAwake)
+    {
+        auto last = m_awakeEntities.back();
+        m_awakeEntities[position] = last;
+        m_awakeIndices[last.getIndex()] = position;
+        m_awakeEntities.pop_back();
+        position = NotAwake;
+    }
+}
+
+void CallbackSystem::insert(const SleepEntry& entry)
+{
+    //each level covers WheelSize times the range of the level below.
+    //entries beyond the range of the top level are re-inserted when they come round
+    const auto delta = entry.wakeTick - m_currentTick;
+    for (auto level = 0u; level < WheelLevels; ++level)
+    {
+        if (delta < (std::uint64_t(1) << (WheelBits * (level + 1)))
+            || level == WheelLevels - 1)
+        {
+            auto tick = entry.wakeTick;
+            if (level == WheelLevels - 1 && delta >= (std::uint64_t(1) << (WheelBits * WheelLevels)))
+            {
+                tick = m_currentTick + (std::uint64_t(1) << (WheelBits * WheelLevels)) - 1;
+            }
+            m_wheel[level][(tick >> (WheelBits * level)) & (WheelSize - 1)].push_back(entry);
+            return;
+        }
+    }
+}
+
+void CallbackSystem::advance()
+{
+    m_currentTick++;
+
+    //when a lower level wraps round move the next slot of the level above down,
+    //starting with the highest level so entries can cascade more than one level
+    auto topLevel = 0u;
+    while (topLevel < WheelLevels - 1
+        && (m_currentTick & ((std::uint64_t(1) << (WheelBits * (topLevel + 1))) - 1)) == 0)
+    {
+        topLevel++;
+    }
+
+    for (auto level = topLevel; level > 0; --level)
+    {
+        m_expiredEntries.swap(m_wheel[level][(m_currentTick >> (WheelBits * level)) & (WheelSize - 1)]);
+        for (const auto& entry : m_expiredEntries)
+        {
+            insert(entry);
+        }
+        m_expiredEntries.clear();
+    }
+
+    m_expiredEntries.swap(m_wheel[0][m_currentTick & (WheelSize - 1)]);
+    for (const auto& entry : m_expiredEntries)
+    {
+        //entries are invalidated by waking early or being removed from the system
+        const auto index = entry.entity.getIndex();
+        if (m_sleepStamps[index] != entry.stamp)
+        {
+            continue;
+        }
+
+        if (entry.wakeTick > m_currentTick)
+        {
+            insert(entry);
+            continue;
+        }
+
+        auto entity = entry.entity;
+        entity.getComponent<Callback>().m_sleeping = false;
+        m_sleepStamps[index]++;
+        addAwake(entity);
     }
+    m_expiredEntries.clear();
+}
+
+void CallbackSystem::onEntityAdded(Entity entity)
+{
+    const auto index = entity.getIndex();
+    if (index >= m_awakeIndices.size())
+    {
+        m_awakeIndices.resize(index + 1, NotAwake);
+        m_sleepStamps.resize(index + 1, 0);
+    }
+
+    auto& cb = entity.getComponent<Callback>();
+    cb.m_sleeping = false;
+    addAwake(entity);
+
+    if (cb.m_sleepRequest != Callback::SleepRequest::None)
+    {
+        sleep(entity, cb);
+    }
+}
+
+void CallbackSystem::onEntityRemoved(Entity entity)
+{
+    removeAwake(entity);
+    m_sleepStamps[entity.getIndex()]++;
 }
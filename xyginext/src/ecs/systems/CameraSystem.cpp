@@ -37,19 +37,17 @@ using namespace xy;
 CameraSystem::CameraSystem(MessageBus& mb)
     : System(mb, typeid(CameraSystem))
 {
-    requireComponent<Transform>();
+    requireComponent<Transform>(ComponentAccess::Read);
     requireComponent<Camera>();
+
+    setConcurrent(true);
 }
 
 //public
 void CameraSystem::process(float)
 {
-    auto& entities = getEntities();
-    for (auto& entity : entities)
+    each<Camera, Transform>([](Entity, Camera& cam, const Transform& xForm)
     {
-        auto& cam = entity.getComponent<Camera>();
-        const auto& xForm = entity.getComponent<Transform>();
-       
         auto position = xForm.getWorldTransform().transformPoint({});
 
         //check axis lock
@@ -74,5 +72,5 @@ void CameraSystem::process(float)
         {
             cam.m_view.setRotation(xForm.getRotation());
         }
-    }
+    });
 }
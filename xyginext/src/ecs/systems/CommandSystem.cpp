@@ -27,50 +27,190 @@ source distribution.
 
 #include "xyginext/ecs/components/CommandTarget.hpp"
 #include "xyginext/ecs/systems/CommandSystem.hpp"
+#include "xyginext/core/Assert.hpp"
+
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 using namespace xy;
 
 namespace
 {
-    const std::size_t MaxCommands = 128; //this can be made larger if necessary, is only used to prevent continual reallocation of heap memory
+    const std::size_t InitialCommandCount = 128; //only used to prevent continual reallocation of heap memory, the queue grows as needed
+
+    //index of the lowest set bit. bits must not be 0
+    std::size_t lowestBit(sf::Uint32 bits)
+    {
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanForward(&index, bits);
+        return index;
+#else
+        return __builtin_ctz(bits);
+#endif
+    }
 }
 
 CommandSystem::CommandSystem(MessageBus& mb)
     : System        (mb, typeid(CommandSystem)),
-    m_commands      (MaxCommands),
-    m_commandBuffer (MaxCommands),
-    m_count         (0)
+    m_commandIndex  (0)
 {
     requireComponent<CommandTarget>();
+
+    m_commands.reserve(InitialCommandCount);
+    m_commandBuffer.reserve(InitialCommandCount);
 }
 
 //public
 void CommandSystem::sendCommand(const Command& cmd)
 {
-
-    //XY_ASSERT(m_currentCommand != m_commands.end(), "Exceeded max commands!");
-
-    if (m_count == MaxCommands) return;
-
-    m_commandBuffer[m_count++] = cmd;
+    m_commandBuffer.push_back(cmd);
 }
 
 void CommandSystem::process(float dt)
 {
-    auto count = m_count;
-    m_count = 0;
+    if (m_commandBuffer.empty())
+    {
+        return;
+    }
+
     m_commands.swap(m_commandBuffer);
-    
-    auto& entities = getEntities();
 
-    for (auto i = 0u; i < count; ++i)
+    for (const auto& cmd : m_commands)
     {
-        for (auto& e : entities)
+        //apply any ID changes made by previous commands
+        updateBuckets();
+
+        //entities with more than one matching bit appear in more than one
+        //bucket, so mark each visit to make sure the command is only executed once
+        ++m_commandIndex;
+        const bool multipleBuckets = (cmd.targetFlags & (cmd.targetFlags - 1)) != 0;
+
+        auto flags = cmd.targetFlags;
+        while (flags)
         {
-            if (e.getComponent<CommandTarget>().ID & m_commands[i].targetFlags)
+            const auto bit = lowestBit(flags);
+            flags &= flags - 1;
+
+            //setID() only marks the target dirty, so buckets are not modified while iterating
+            for (auto entity : m_buckets[bit].entities)
             {
-                m_commands[i].action(e, dt);
+                if (multipleBuckets)
+                {
+                    auto& visited = m_visited[entity.getIndex()];
+                    if (visited == m_commandIndex)
+                    {
+                        continue;
+                    }
+                    visited = m_commandIndex;
+                }
+
+                //the ID may have been changed by this command
+                if (entity.getComponent<CommandTarget>().getID() & cmd.targetFlags)
+                {
+                    cmd.action(entity, dt);
+                }
             }
         }
     }
+    m_commands.clear();
+}
+
+//private
+void CommandSystem::markDirty(Entity entity)
+{
+    m_dirtyTargets.push_back(entity);
+}
+
+void CommandSystem::updateBuckets()
+{
+    for (auto entity : m_dirtyTargets)
+    {
+        auto& target = entity.getComponent<CommandTarget>();
+        target.m_dirty = false;
+
+        const auto id = target.getID();
+        const auto oldID = m_targetIDs[entity.getIndex()];
+        if (id != oldID)
+        {
+            removeFromBuckets(entity, oldID & ~id);
+            addToBuckets(entity, id & ~oldID);
+            m_targetIDs[entity.getIndex()] = id;
+        }
+    }
+    m_dirtyTargets.clear();
+}
+
+void CommandSystem::addToBuckets(Entity entity, sf::Uint32 bits)
+{
+    const auto index = entity.getIndex();
+    while (bits)
+    {
+        auto& bucket = m_buckets[lowestBit(bits)];
+        if (index >= bucket.positions.size())
+        {
+            bucket.positions.resize(index + 1, 0);
+        }
+        bucket.positions[index] = bucket.entities.size();
+        bucket.entities.push_back(entity);
+
+        bits &= bits - 1;
+    }
+}
+
+void CommandSystem::removeFromBuckets(Entity entity, sf::Uint32 bits)
+{
+    const auto index = entity.getIndex();
+    while (bits)
+    {
+        auto& bucket = m_buckets[lowestBit(bits)];
+        const auto position = bucket.positions[index];
+        XY_ASSERT(position < bucket.entities.size() && bucket.entities[position] == entity, "Entity not in bucket");
+
+        auto last = bucket.entities.back();
+        bucket.entities[position] = last;
+        bucket.positions[last.getIndex()] = position;
+        bucket.entities.pop_back();
+
+        bits &= bits - 1;
+    }
+}
+
+void CommandSystem::onEntityAdded(Entity entity)
+{
+    const auto index = entity.getIndex();
+    if (index >= m_targetIDs.size())
+    {
+        m_targetIDs.resize(index + 1, 0);
+        m_visited.resize(index + 1, 0);
+    }
+
+    auto& target = entity.getComponent<CommandTarget>();
+    target.m_commandSystem = this;
+    target.m_entity = entity;
+    target.m_dirty = false;
+
+    const auto id = target.getID();
+    m_targetIDs[index] = id;
+    m_visited[index] = 0;
+    addToBuckets(entity, id);
+}
+
+void CommandSystem::onEntityRemoved(Entity entity)
+{
+    auto& target = entity.getComponent<CommandTarget>();
+    target.m_commandSystem = nullptr;
+    target.m_dirty = false;
+
+    //a copied CommandTarget may have marked this entity without setting its flag, so always check
+    if (!m_dirtyTargets.empty())
+    {
+        m_dirtyTargets.erase(std::remove(m_dirtyTargets.begin(), m_dirtyTargets.end(), entity), m_dirtyTargets.end());
+    }
+
+    removeFromBuckets(entity, m_targetIDs[entity.getIndex()]);
+    m_targetIDs[entity.getIndex()] = 0;
 }
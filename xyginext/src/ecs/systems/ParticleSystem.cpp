@@ -29,6 +29,8 @@ source distribution.
 #include "xyginext/ecs/components/Transform.hpp"
 #include "xyginext/ecs/components/ParticleEmitter.hpp"
 #include "xyginext/core/App.hpp"
+#include "xyginext/core/JobSystem.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
 #include "xyginext/util/Const.hpp"
 #include "xyginext/util/Random.hpp"
 #include "xyginext/util/Vector.hpp"
@@ -38,6 +40,7 @@ source distribution.
 
 #include "../../detail/GLCheck.hpp"
 
+#include <algorithm>
 #include <limits>
 
 #ifndef GL_PROGRAM_POINT_SIZE
@@ -84,6 +87,7 @@ namespace
 
     const std::size_t MaxParticleSystems = 64; //max VBOs, must be divisible by min count
     const std::size_t MinParticleSystems = 4; //min amount before resizing. This many are added on resize
+    const std::size_t EmittersPerJob = 4; //emitters updated by each job when processing in parallel
 }
 
 ParticleSystem::ParticleSystem(xy::MessageBus& mb)
@@ -92,7 +96,9 @@ ParticleSystem::ParticleSystem(xy::MessageBus& mb)
     m_activeArrayCount  (0)
 {
     requireComponent<ParticleEmitter>();
-    requireComponent<Transform>();
+    requireComponent<Transform>(ComponentAccess::Read);
+
+    setConcurrent(true);
 
     if (!m_shader.loadFromMemory(VertexShader, FragmentShader))
     {
@@ -166,67 +172,83 @@ void ParticleSystem::process(float dt)
             }
         }
         if (emitter.m_releaseCount == 0) emitter.stop();
+    }
 
-        //update each particle
-        sf::Vector2f minBounds(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
-        sf::Vector2f maxBounds;
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+    //emission uses the shared random engine so is done above, but the
+    //emitters are otherwise independent so can be updated in parallel.
+    //each emitter writes to the vertex array matching its index
+    JobSystem::parallelFor("xy::ParticleSystem", entities.size(), EmittersPerJob,
+        [&, dt](std::size_t begin, std::size_t end)
+    {
+        for (auto j = begin; j < end; ++j)
         {
-            auto& p = emitter.m_particles[i];
+            updateEmitter(entities[j].getComponent<ParticleEmitter>(), j, dt);
+        }
+    });
+    m_activeArrayCount = std::min(entities.size(), MaxParticleSystems);
+}
 
-            p.velocity += p.gravity * dt;
-            for (auto f : emitter.settings.forces) p.velocity += f * dt;
-            p.position += p.velocity * dt;
+//private
+void ParticleSystem::updateEmitter(ParticleEmitter& emitter, std::size_t arrayIndex, float dt)
+{
+    //update each particle
+    sf::Vector2f minBounds(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    sf::Vector2f maxBounds;
+    for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+    {
+        auto& p = emitter.m_particles[i];
 
-            p.lifetime -= dt;
-            p.colour.a = static_cast<sf::Uint8>(255.f * (std::max(p.lifetime / p.maxLifetime, 0.f)));
+        p.velocity += p.gravity * dt;
+        for (auto f : emitter.settings.forces) p.velocity += f * dt;
+        p.position += p.velocity * dt;
 
-            p.rotation += emitter.settings.rotationSpeed * dt;
-            p.scale += ((p.scale * emitter.settings.scaleModifier) * dt);
+        p.lifetime -= dt;
+        p.colour.a = static_cast<sf::Uint8>(255.f * (std::max(p.lifetime / p.maxLifetime, 0.f)));
 
-            //update bounds for culling
-            if (p.position.x < minBounds.x) minBounds.x = p.position.x;
-            if (p.position.y < minBounds.y) minBounds.y = p.position.y;
+        p.rotation += emitter.settings.rotationSpeed * dt;
+        p.scale += ((p.scale * emitter.settings.scaleModifier) * dt);
 
-            if (p.position.x > maxBounds.x) maxBounds.x = p.position.x;
-            if (p.position.y > maxBounds.y) maxBounds.y = p.position.y;
-        }
-        emitter.m_bounds = { minBounds, maxBounds - minBounds };
+        //update bounds for culling
+        if (p.position.x < minBounds.x) minBounds.x = p.position.x;
+        if (p.position.y < minBounds.y) minBounds.y = p.position.y;
+
+        if (p.position.x > maxBounds.x) maxBounds.x = p.position.x;
+        if (p.position.y > maxBounds.y) maxBounds.y = p.position.y;
+    }
+    emitter.m_bounds = { minBounds, maxBounds - minBounds };
 
 
-        //go over again and remove dead particles with pop/swap
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+    //go over again and remove dead particles with pop/swap
+    for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+    {
+        if (emitter.m_particles[i].lifetime < 0)
         {
-            if (emitter.m_particles[i].lifetime < 0)
-            {
-                emitter.m_nextFreeParticle--;
-                std::swap(emitter.m_particles[i], emitter.m_particles[emitter.m_nextFreeParticle]);
-            }
+            emitter.m_nextFreeParticle--;
+            std::swap(emitter.m_particles[i], emitter.m_particles[emitter.m_nextFreeParticle]);
         }
+    }
 
-        //limit max number of active systems and generate actual vert array
-        if (m_activeArrayCount < MaxParticleSystems) 
-        {
-            auto& vertArray = m_emitterArrays[m_activeArrayCount++];
-            vertArray.count = 0;
-            vertArray.texture = (emitter.settings.texture) ? emitter.settings.texture : &m_dummyTexture;
-            vertArray.bounds = emitter.m_bounds;
-            vertArray.blendMode = emitter.settings.blendmode;
+    //limit max number of active systems and generate actual vert array
+    if (arrayIndex < MaxParticleSystems) 
+    {
+        auto& vertArray = m_emitterArrays[arrayIndex];
+        vertArray.count = 0;
+        vertArray.texture = (emitter.settings.texture) ? emitter.settings.texture : &m_dummyTexture;
+        vertArray.bounds = emitter.m_bounds;
+        vertArray.blendMode = emitter.settings.blendmode;
 
-            for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+        {
+            vertArray.vertices[vertArray.count++] = 
             {
-                vertArray.vertices[vertArray.count++] = 
-                {
-                    emitter.m_particles[i].position,
-                    emitter.m_particles[i].colour,
-                    sf::Vector2f(emitter.m_particles[i].rotation, emitter.m_particles[i].scale)
-                };
-            }
+                emitter.m_particles[i].position,
+                emitter.m_particles[i].colour,
+                sf::Vector2f(emitter.m_particles[i].rotation, emitter.m_particles[i].scale)
+            };
         }
     }
 }
 
-//private
 void ParticleSystem::onEntityAdded(xy::Entity)
 {
     m_arrayCount++;
@@ -259,6 +281,11 @@ void ParticleSystem::draw(sf::RenderTarget& rt, sf::RenderStates states) const
     states.shader = &m_shader;
     states.texture = &m_dummyTexture;
     
+    RenderStats stats;
+    stats.shaderChanges = 1;
+    const sf::Texture* previousTexture = nullptr;
+    sf::BlendMode previousBlendMode = sf::BlendNone;
+
     glCheck(glEnable(GL_PROGRAM_POINT_SIZE));
     glCheck(glEnable(GL_POINT_SPRITE));
     for (auto i = 0u; i < m_activeArrayCount; ++i)
@@ -269,8 +296,28 @@ void ParticleSystem::draw(sf::RenderTarget& rt, sf::RenderStates states) const
             states.blendMode = m_emitterArrays[i].blendMode;
             rt.draw(m_emitterArrays[i].vertices.data(), m_emitterArrays[i].count, sf::Points, states);
             //DPRINT("Particle Count", std::to_string(m_emitterArrays[i].count));
+
+            stats.drawCalls++;
+            stats.drawablesDrawn++;
+            stats.vertexCount += m_emitterArrays[i].count;
+            if (m_emitterArrays[i].texture != previousTexture)
+            {
+                stats.textureChanges++;
+                previousTexture = m_emitterArrays[i].texture;
+            }
+            if (states.blendMode != previousBlendMode)
+            {
+                stats.blendModeChanges++;
+                previousBlendMode = states.blendMode;
+            }
+        }
+        else
+        {
+            stats.drawablesCulled++;
         }
     }
     glCheck(glDisable(GL_PROGRAM_POINT_SIZE));
     glCheck(glDisable(GL_POINT_SPRITE));
+
+    RenderStats::addToFrame(stats);
 }
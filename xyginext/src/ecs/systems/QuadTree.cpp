@@ -44,9 +44,11 @@ QuadTree::QuadTree(xy::MessageBus& mb, sf::FloatRect rootArea)
     : xy::System(mb, typeid(QuadTree)),
     m_rootNode(rootArea, 0, nullptr, this)
 {
-    requireComponent<xy::Transform>();
+    requireComponent<xy::Transform>(xy::ComponentAccess::Read);
     requireComponent<xy::QuadTreeItem>();
 
+    setConcurrent(true);
+
     m_queryVector.reserve(MaxNodeEntities * MaxLevels);
 }
 
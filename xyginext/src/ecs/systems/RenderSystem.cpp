@@ -32,57 +32,132 @@ source distribution.
 
 #include "xyginext/util/Rectangle.hpp"
 
+#include "../../detail/GLCheck.hpp"
+
 #include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Shader.hpp>
-#include <SFML/OpenGL.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <array>
+
+namespace
+{
+    //spreads a pointer across the given number of bits. collisions
+    //only mean that two states may not be grouped together
+    std::uint64_t hashPointer(const void* ptr, std::uint32_t bits)
+    {
+        const auto value = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr));
+        return ptr ? ((value >> 4) * 0x9E3779B97F4A7C15ull) >> (64 - bits) : 0;
+    }
+
+    std::uint64_t hashBlendMode(const sf::BlendMode& mode)
+    {
+        std::uint64_t value = mode.colorSrcFactor;
+        value = (value << 4) | mode.colorDstFactor;
+        value = (value << 4) | mode.colorEquation;
+        value = (value << 4) | mode.alphaSrcFactor;
+        value = (value << 4) | mode.alphaDstFactor;
+        value = (value << 4) | mode.alphaEquation;
+        return (value * 0x9E3779B97F4A7C15ull) >> 56;
+    }
+
+    //depth | shader (or material) | texture | blend mode
+    std::uint64_t sortKey(sf::Int32 depth, const sf::RenderStates& states, const xy::Material* material)
+    {
+        const void* shader = material ? static_cast<const void*>(material) : states.shader;
+        //flip the sign bit so negative depths sort before positive ones
+        const auto depthBits = static_cast<std::uint64_t>(static_cast<std::uint32_t>(depth) ^ 0x80000000u);
+        return (depthBits << 32)
+            | (hashPointer(shader, 12) << 20)
+            | (hashPointer(states.texture, 12) << 8)
+            | hashBlendMode(states.blendMode);
+    }
+
+    //primitives which can be concatenated into a single draw call
+    bool isBatchable(sf::PrimitiveType type)
+    {
+        return type == sf::Quads || type == sf::Triangles
+            || type == sf::Lines || type == sf::Points;
+    }
+
+    //size of the world grid used to split static geometry into chunks, so
+    //that chunks can be culled and one change doesn't rebuild a whole level
+    const float StaticCellSize = 1024.f;
+    const std::size_t MaxStaticChunkDrawables = 4096;
+}
 
 xy::RenderSystem::RenderSystem(xy::MessageBus& mb)
-    : xy::System(mb, typeid(xy::RenderSystem)),
-    m_wantsSorting  (true)
+    : xy::System        (mb, typeid(xy::RenderSystem)),
+    m_drawStamp         (0),
+    m_broadphaseCulling (false),
+    m_renderOrderDirty  (true),
+    m_cullResultCount   (0)
 {
     requireComponent<xy::Drawable>();
-    requireComponent<xy::Transform>();
+    requireComponent<xy::Transform>(xy::ComponentAccess::Read);
+
+    //entities are kept in sort key order
+    setStableRemoval(true);
+    setConcurrent(true);
 }
 
 //public
 void xy::RenderSystem::process(float)
 {
-    auto& entities = getEntities();
-    for (auto& entity : entities)
-    {
-        auto& drawable = entity.getComponent<xy::Drawable>();
-        if (drawable.m_wantsSorting)
-        {
-            drawable.m_wantsSorting = false;
-            m_wantsSorting = true;
-        }
+    m_renderQueue.clear();
+    m_unculledEntities.clear();
 
+    each<xy::Drawable, xy::Transform>([this](xy::Entity entity, xy::Drawable& drawable, const xy::Transform& tx)
+    {
         //update cropping area
         drawable.m_cropped = !Util::Rectangle::contains(drawable.m_croppingArea, drawable.m_localBounds);
 
         if (drawable.m_cropped)
         {
-            const auto& xForm = entity.getComponent<Transform>().getWorldTransform();
+            const auto& xForm = tx.getWorldTransform();
 
             //update world positions
             drawable.m_croppingWorldArea = xForm.transformRect(drawable.m_croppingArea);
             drawable.m_croppingWorldArea.top += drawable.m_croppingWorldArea.height;
             drawable.m_croppingWorldArea.height = -drawable.m_croppingWorldArea.height;
         }
-    }
 
-    //do Z sorting
-    if (m_wantsSorting)
+        if (m_broadphaseCulling)
+        {
+            updateBroadphase(entity, drawable, tx);
+        }
+
+        updateStaticGeometry(entity, drawable, tx);
+
+        m_renderQueue.push_back({ sortKey(drawable.m_zDepth, drawable.m_states, drawable.m_material), entity });
+    });
+
+    //the queue is built in last frame's order, so is usually already sorted
+    if (!std::is_sorted(m_renderQueue.begin(), m_renderQueue.end(),
+        [](const RenderItem& a, const RenderItem& b)
     {
-        m_wantsSorting = false;
+        return a.key < b.key;
+    }))
+    {
+        sortRenderQueue();
 
-        std::sort(entities.begin(), entities.end(),
-            [](const Entity& entA, const Entity& entB)
+        auto& entities = getEntities();
+        for (auto i = 0u; i < m_renderQueue.size(); ++i)
         {
-            return entA.getComponent<xy::Drawable>().getDepth() < entB.getComponent<xy::Drawable>().getDepth();
-        });
+            entities[i] = m_renderQueue[i].entity;
+        }
+        m_renderOrderDirty = true;
     }
+
+    rebuildStaticChunks();
+
+    //previous query results are no longer valid
+    m_cullResultCount = 0;
 }
 
 void xy::RenderSystem::setCullingBorder(float size)
@@ -90,59 +165,613 @@ void xy::RenderSystem::setCullingBorder(float size)
     m_cullingBorder = { size, size };
 }
 
+void xy::RenderSystem::setBroadphaseCulling(bool enabled)
+{
+    if (enabled != m_broadphaseCulling)
+    {
+        m_broadphaseCulling = enabled;
+
+        //proxies are (re)created on the next update
+        m_tree.clear();
+        for (auto& data : m_cullData)
+        {
+            data = {};
+        }
+        m_unculledEntities.clear();
+        m_cullResultCount = 0;
+        m_renderOrderDirty = true;
+    }
+}
+
+const xy::RenderStats& xy::RenderSystem::prepareBatches(const sf::View& view) const
+{
+    sf::FloatRect viewableArea((view.getCenter() - (view.getSize() / 2.f)) - m_cullingBorder, view.getSize() + m_cullingBorder);
+    buildBatches(viewableArea);
+    return m_stats;
+}
+
 //private
-void xy::RenderSystem::onEntityAdded(xy::Entity)
+void xy::RenderSystem::sortRenderQueue()
+{
+    //LSD radix sort 8 bits at a time. This is stable, so drawables with
+    //equal keys keep their relative order, and passes where every key has
+    //the same digit (such as the upper depth bits) are skipped
+    static constexpr std::size_t RadixBits = 8;
+    static constexpr std::size_t RadixSize = 1 << RadixBits;
+    static constexpr std::size_t PassCount = 64 / RadixBits;
+
+    std::array<std::array<std::size_t, RadixSize>, PassCount> histograms = {};
+    for (const auto& item : m_renderQueue)
+    {
+        for (auto pass = 0u; pass < PassCount; ++pass)
+        {
+            histograms[pass][(item.key >> (pass * RadixBits)) & (RadixSize - 1)]++;
+        }
+    }
+
+    m_sortBuffer.resize(m_renderQueue.size());
+    for (auto pass = 0u; pass < PassCount; ++pass)
+    {
+        auto& histogram = histograms[pass];
+        const auto digit = (m_renderQueue[0].key >> (pass * RadixBits)) & (RadixSize - 1);
+        if (histogram[digit] == m_renderQueue.size())
+        {
+            continue;
+        }
+
+        std::size_t offset = 0;
+        for (auto& count : histogram)
+        {
+            const auto next = offset + count;
+            count = offset;
+            offset = next;
+        }
+
+        for (const auto& item : m_renderQueue)
+        {
+            m_sortBuffer[histogram[(item.key >> (pass * RadixBits)) & (RadixSize - 1)]++] = item;
+        }
+        m_renderQueue.swap(m_sortBuffer);
+    }
+}
+
+void xy::RenderSystem::updateBroadphase(xy::Entity entity, const xy::Drawable& drawable, const xy::Transform& tx)
+{
+    auto& data = m_cullData[entity.getIndex()];
+
+    if (!drawable.m_cull)
+    {
+        if (data.proxyID != DynamicTree::NullNode)
+        {
+            m_tree.removeProxy(data.proxyID);
+            data.proxyID = DynamicTree::NullNode;
+        }
+        m_unculledEntities.push_back(entity.getIndex());
+        return;
+    }
+
+    const bool transformChanged = tx.worldTransformChanged(data.transformVersion);
+    if (transformChanged
+        || data.boundsVersion != drawable.m_boundsVersion
+        || data.proxyID == DynamicTree::NullNode)
+    {
+        data.boundsVersion = drawable.m_boundsVersion;
+        data.worldBounds = tx.getWorldTransform().transformRect(drawable.m_localBounds);
+
+        if (data.proxyID == DynamicTree::NullNode)
+        {
+            data.proxyID = m_tree.addProxy(data.worldBounds, entity.getIndex());
+        }
+        else
+        {
+            m_tree.moveProxy(data.proxyID, data.worldBounds);
+        }
+    }
+}
+
+const std::vector<std::size_t>& xy::RenderSystem::getVisibleEntities(sf::FloatRect area) const
+{
+    for (auto i = 0u; i < m_cullResultCount; ++i)
+    {
+        if (m_cullResults[i].area == area)
+        {
+            return m_cullResults[i].visible;
+        }
+    }
+
+    const auto& entities = getEntities();
+    if (m_renderOrderDirty)
+    {
+        m_renderOrder.resize(m_cullData.size());
+        for (auto i = 0u; i < entities.size(); ++i)
+        {
+            m_renderOrder[entities[i].getIndex()] = i;
+        }
+        m_renderOrderDirty = false;
+    }
+
+    if (m_cullResultCount == m_cullResults.size())
+    {
+        m_cullResults.emplace_back();
+    }
+    auto& result = m_cullResults[m_cullResultCount++];
+    result.area = area;
+    result.visible.clear();
+
+    //the tree stores fat bounds, so test the actual bounds of each result
+    m_queryResults.clear();
+    m_tree.query(area, m_queryResults);
+    for (auto index : m_queryResults)
+    {
+        if (m_cullData[index].worldBounds.intersects(area))
+        {
+            result.visible.push_back(m_renderOrder[index]);
+        }
+    }
+
+    for (auto index : m_unculledEntities)
+    {
+        result.visible.push_back(m_renderOrder[index]);
+    }
+
+    std::sort(result.visible.begin(), result.visible.end());
+    return result.visible;
+}
+
+void xy::RenderSystem::onEntityAdded(xy::Entity entity)
+{
+    if (entity.getIndex() >= m_cullData.size())
+    {
+        m_cullData.resize(entity.getIndex() + 1);
+        m_staticData.resize(entity.getIndex() + 1);
+    }
+    m_cullData[entity.getIndex()] = {};
+    m_staticData[entity.getIndex()] = {};
+
+    m_renderOrderDirty = true;
+    m_cullResultCount = 0;
+}
+
+void xy::RenderSystem::onEntityRemoved(xy::Entity entity)
+{
+    auto& data = m_cullData[entity.getIndex()];
+    if (data.proxyID != DynamicTree::NullNode)
+    {
+        m_tree.removeProxy(data.proxyID);
+    }
+    data = {};
+
+    if (m_staticData[entity.getIndex()].chunk != -1)
+    {
+        removeFromStaticChunk(entity);
+    }
+
+    m_unculledEntities.erase(std::remove(m_unculledEntities.begin(), m_unculledEntities.end(), entity.getIndex()), m_unculledEntities.end());
+    m_renderOrderDirty = true;
+    m_cullResultCount = 0;
+}
+
+bool xy::RenderSystem::StaticKey::operator == (const StaticKey& other) const
+{
+    return depth == other.depth
+        && texture == other.texture
+        && shader == other.shader
+        && material == other.material
+        && blendMode == other.blendMode
+        && primitiveType == other.primitiveType
+        && cull == other.cull
+        && cell == other.cell;
+}
+
+std::uint64_t xy::RenderSystem::StaticKey::hash() const
+{
+    const auto material = this->material ? static_cast<const void*>(this->material) : shader;
+    std::uint64_t value = static_cast<std::uint32_t>(depth);
+    value = (value << 12) ^ hashPointer(texture, 12);
+    value = (value << 12) ^ hashPointer(material, 12);
+    value = (value << 8) ^ hashBlendMode(blendMode);
+    value = (value << 4) ^ (static_cast<std::uint64_t>(primitiveType) << 1) ^ (cull ? 1 : 0);
+    value ^= (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell.x)) * 0x9E3779B97F4A7C15ull);
+    value ^= (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell.y)) * 0xC2B2AE3D27D4EB4Full);
+    return value;
+}
+
+void xy::RenderSystem::updateStaticGeometry(xy::Entity entity, const xy::Drawable& drawable, const xy::Transform& tx)
+{
+    auto& data = m_staticData[entity.getIndex()];
+
+    const bool isStatic = drawable.m_static
+        && !drawable.m_cropped
+        && isBatchable(drawable.m_primitiveType)
+        && !drawable.hasUniformBindings();
+
+    if (!isStatic)
+    {
+        if (data.chunk != -1)
+        {
+            removeFromStaticChunk(entity);
+        }
+        return;
+    }
+
+    const bool transformChanged = tx.worldTransformChanged(data.transformVersion);
+    const bool verticesChanged = (data.vertexVersion != drawable.m_vertexVersion);
+    data.vertexVersion = drawable.m_vertexVersion;
+
+    StaticKey key;
+    key.depth = drawable.m_zDepth;
+    key.texture = drawable.m_states.texture;
+    key.shader = drawable.m_states.shader;
+    key.material = drawable.m_material;
+    key.blendMode = drawable.m_states.blendMode;
+    key.primitiveType = drawable.m_primitiveType;
+    key.cull = drawable.m_cull;
+    key.cell = data.key.cell;
+
+    if (transformChanged || verticesChanged || data.chunk == -1)
+    {
+        const auto bounds = tx.getWorldTransform().transformRect(drawable.m_localBounds);
+        key.cell.x = static_cast<int>(std::floor((bounds.left + (bounds.width / 2.f)) / StaticCellSize));
+        key.cell.y = static_cast<int>(std::floor((bounds.top + (bounds.height / 2.f)) / StaticCellSize));
+    }
+
+    if (data.chunk != -1)
+    {
+        if (key == data.key)
+        {
+            if (transformChanged || verticesChanged)
+            {
+                m_staticChunks[data.chunk]->dirty = true;
+            }
+            return;
+        }
+        removeFromStaticChunk(entity);
+    }
+
+    addToStaticChunk(entity, key);
+}
+
+void xy::RenderSystem::addToStaticChunk(xy::Entity entity, const StaticKey& key)
+{
+    const auto hash = key.hash();
+    std::size_t chunkIndex = m_staticChunks.size();
+
+    auto [first, last] = m_staticChunkLookup.equal_range(hash);
+    for (auto it = first; it != last; ++it)
+    {
+        const auto& chunk = *m_staticChunks[it->second];
+        if (chunk.key == key && chunk.entities.size() < MaxStaticChunkDrawables)
+        {
+            chunkIndex = it->second;
+            break;
+        }
+    }
+
+    if (chunkIndex == m_staticChunks.size())
+    {
+        if (!m_freeStaticChunks.empty())
+        {
+            chunkIndex = m_freeStaticChunks.back();
+            m_freeStaticChunks.pop_back();
+        }
+        else
+        {
+            m_staticChunks.emplace_back(std::make_unique<StaticChunk>());
+        }
+        m_staticChunks[chunkIndex]->key = key;
+        m_staticChunkLookup.emplace(hash, chunkIndex);
+    }
+
+    auto& chunk = *m_staticChunks[chunkIndex];
+    chunk.entities.push_back(entity);
+    chunk.dirty = true;
+
+    auto& data = m_staticData[entity.getIndex()];
+    data.chunk = static_cast<std::int32_t>(chunkIndex);
+    data.key = key;
+}
+
+void xy::RenderSystem::removeFromStaticChunk(xy::Entity entity)
+{
+    auto& data = m_staticData[entity.getIndex()];
+    const auto chunkIndex = static_cast<std::size_t>(data.chunk);
+    data.chunk = -1;
+
+    auto& chunk = *m_staticChunks[chunkIndex];
+    chunk.entities.erase(std::remove(chunk.entities.begin(), chunk.entities.end(), entity), chunk.entities.end());
+    chunk.dirty = true;
+
+    if (chunk.entities.empty())
+    {
+        auto [first, last] = m_staticChunkLookup.equal_range(chunk.key.hash());
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->second == chunkIndex)
+            {
+                m_staticChunkLookup.erase(it);
+                break;
+            }
+        }
+        chunk.vertices.clear();
+        chunk.dirty = false;
+        m_freeStaticChunks.push_back(chunkIndex);
+    }
+}
+
+void xy::RenderSystem::rebuildStaticChunks()
+{
+    for (auto& chunk : m_staticChunks)
+    {
+        if (!chunk->dirty)
+        {
+            continue;
+        }
+
+        chunk->vertices.clear();
+        sf::Vector2f lower(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        sf::Vector2f upper(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+
+        for (auto entity : chunk->entities)
+        {
+            const auto& drawable = entity.getComponent<xy::Drawable>();
+            const auto tx = entity.getComponent<xy::Transform>().getWorldTransform();
+
+            for (auto v : drawable.m_vertices)
+            {
+                v.position = tx.transformPoint(v.position);
+                chunk->vertices.push_back(v);
+
+                lower.x = std::min(lower.x, v.position.x);
+                lower.y = std::min(lower.y, v.position.y);
+                upper.x = std::max(upper.x, v.position.x);
+                upper.y = std::max(upper.y, v.position.y);
+            }
+        }
+        chunk->bounds = chunk->vertices.empty() ? sf::FloatRect() : Util::Rectangle::fromBounds(lower, upper);
+        chunk->dirty = false;
+        chunk->uploaded = false;
+    }
+}
+
+void xy::RenderSystem::buildBatches(sf::FloatRect viewableArea) const
 {
-    m_wantsSorting = true;
+    m_batches.clear();
+    m_batchVertices.clear();
+    m_stats = {};
+    m_drawStamp++;
+
+    //static drawables are drawn with their chunk, the first time one of them is reached
+    auto addStatic = [&](xy::Entity entity, const xy::Drawable& drawable)
+    {
+        const auto chunkIndex = m_staticData[entity.getIndex()].chunk;
+        if (chunkIndex == -1)
+        {
+            return false;
+        }
+
+        const auto& chunk = *m_staticChunks[chunkIndex];
+        if (chunk.drawStamp != m_drawStamp)
+        {
+            chunk.drawStamp = m_drawStamp;
+            if (!chunk.key.cull || chunk.bounds.intersects(viewableArea))
+            {
+                auto& batch = m_batches.emplace_back();
+                batch.drawable = &drawable;
+                batch.chunk = &chunk;
+                batch.vertexCount = chunk.vertices.size();
+                batch.drawableCount = chunk.entities.size();
+
+                m_stats.drawablesDrawn += chunk.entities.size();
+                m_stats.vertexCount += chunk.vertices.size();
+                if (chunk.entities.size() > 1)
+                {
+                    m_stats.batchedDrawables += chunk.entities.size();
+                }
+            }
+        }
+        return true;
+    };
+
+    auto addDrawable = [&](const xy::Drawable& drawable, const sf::Transform& tx)
+    {
+        m_stats.drawablesDrawn++;
+        m_stats.vertexCount += drawable.m_vertices.size();
+
+        const bool batchable = !drawable.m_cropped
+            && isBatchable(drawable.m_primitiveType)
+            && !drawable.hasUniformBindings();
+
+        if (batchable && !m_batches.empty())
+        {
+            auto& batch = m_batches.back();
+            const auto& first = *batch.drawable;
+            if (batch.batchable
+                && first.m_primitiveType == drawable.m_primitiveType
+                && first.m_states.texture == drawable.m_states.texture
+                && first.m_states.shader == drawable.m_states.shader
+                && first.m_material == drawable.m_material
+                && first.m_states.blendMode == drawable.m_states.blendMode)
+            {
+                //move the first drawable's vertices to world space once a second one joins
+                if (batch.drawableCount == 1)
+                {
+                    batch.vertexStart = m_batchVertices.size();
+                    for (auto v : first.m_vertices)
+                    {
+                        v.position = batch.transform.transformPoint(v.position);
+                        m_batchVertices.push_back(v);
+                    }
+                    m_stats.batchedDrawables++;
+                }
+
+                for (auto v : drawable.m_vertices)
+                {
+                    v.position = tx.transformPoint(v.position);
+                    m_batchVertices.push_back(v);
+                }
+                batch.vertexCount = m_batchVertices.size() - batch.vertexStart;
+                batch.drawableCount++;
+                m_stats.batchedDrawables++;
+                return;
+            }
+        }
+
+        auto& batch = m_batches.emplace_back();
+        batch.drawable = &drawable;
+        batch.transform = tx;
+        batch.vertexCount = drawable.m_vertices.size();
+        batch.drawableCount = 1;
+        batch.batchable = batchable;
+    };
+
+    if (m_broadphaseCulling)
+    {
+        const auto& entities = getEntities();
+        const auto& visible = getVisibleEntities(viewableArea);
+        for (auto i : visible)
+        {
+            auto entity = entities[i];
+            const auto& drawable = entity.getComponent<xy::Drawable>();
+            if (!addStatic(entity, drawable))
+            {
+                addDrawable(drawable, entity.getComponent<xy::Transform>().getWorldTransform());
+            }
+        }
+    }
+    else
+    {
+        each<xy::Drawable, xy::Transform>([&](xy::Entity entity, const xy::Drawable& drawable, const xy::Transform& transform)
+        {
+            if (addStatic(entity, drawable))
+            {
+                return;
+            }
+
+            const auto& tx = transform.getWorldTransform();
+            const auto bounds = tx.transformRect(drawable.getLocalBounds());
+
+            if (drawable.m_cull && !bounds.intersects(viewableArea))
+            {
+                return;
+            }
+
+            addDrawable(drawable, tx);
+        });
+    }
+
+    m_stats.drawCalls = m_batches.size();
+    m_stats.drawablesCulled = getEntities().size() - m_stats.drawablesDrawn;
 }
 
 void xy::RenderSystem::draw(sf::RenderTarget& rt, sf::RenderStates states) const
 {
-    auto view = rt.getView();
-    sf::FloatRect viewableArea((view.getCenter() - (view.getSize() / 2.f)) - m_cullingBorder, view.getSize() + m_cullingBorder);
+    prepareBatches(rt.getView());
 
     glEnable(GL_SCISSOR_TEST);
-    for (auto entity : getEntities())
+    bool fullScissor = false;
+    //materials are only applied when they change between draw calls
+    const xy::Material* currentMaterial = nullptr;
+    sf::RenderStates previousStates;
+    previousStates.blendMode = sf::BlendNone; //so the first draw counts as a change
+    for (const auto& batch : m_batches)
     {
-        const auto& drawable = entity.getComponent<xy::Drawable>();
-        const auto& tx = entity.getComponent<xy::Transform>().getWorldTransform();
-        const auto bounds = tx.transformRect(drawable.getLocalBounds());
+        const auto& drawable = *batch.drawable;
+
+        if (drawable.m_cropped)
+        {
+            //convert cropping area to target coords (remember this might not be a window!)
+            sf::Vector2f start(drawable.m_croppingWorldArea.left, drawable.m_croppingWorldArea.top);
+            sf::Vector2f end(start.x + drawable.m_croppingWorldArea.width, start.y + drawable.m_croppingWorldArea.height);
 
+            auto scissorStart = rt.mapCoordsToPixel(start);
+            auto scissorEnd = rt.mapCoordsToPixel(end);
+            //Y coords are flipped...
+            auto rtHeight = rt.getSize().y;
+            scissorStart.y = rtHeight - scissorStart.y;
+            scissorEnd.y = rtHeight - scissorEnd.y;
 
-        if (!drawable.m_cull || bounds.intersects(viewableArea))
+            glScissor(scissorStart.x, scissorStart.y, scissorEnd.x - scissorStart.x, scissorEnd.y - scissorStart.y);
+            fullScissor = false;
+            m_stats.scissorChanges++;
+        }
+        else if (!fullScissor)
         {
-            states = drawable.m_states;
-            states.transform = tx;
+            //just set the scissor to the view
+            auto rtSize = rt.getSize();
+            glScissor(0, 0, rtSize.x, rtSize.y);
+            fullScissor = true;
+            m_stats.scissorChanges++;
+        }
 
-            if (states.shader)
+        states = drawable.m_states;
+        if (states.texture != previousStates.texture)
+        {
+            m_stats.textureChanges++;
+        }
+        if (states.shader != previousStates.shader)
+        {
+            m_stats.shaderChanges++;
+        }
+        if (states.blendMode != previousStates.blendMode)
+        {
+            m_stats.blendModeChanges++;
+        }
+        previousStates = states;
+
+        if (states.shader)
+        {
+            //overrides may clobber material values, so are always reapplied
+            const bool applyMaterial = drawable.hasUniformBindings()
+                || (drawable.m_material && drawable.m_material != currentMaterial);
+
+            if (applyMaterial)
             {
+                //uniforms are uploaded to the bound program. SFML binds it again
+                //when drawing, so it only needs binding here once per batch
+                glCheck(glUseProgram(static_cast<GLuint>(states.shader->getNativeHandle())));
                 drawable.applyShader();
+                currentMaterial = drawable.hasUniformBindings() ? nullptr : drawable.m_material;
             }
+        }
 
-            if (drawable.m_cropped)
+        if (batch.chunk)
+        {
+            //static geometry is already in world space
+            const auto& chunk = *batch.chunk;
+            states.transform = sf::Transform::Identity;
+            if (sf::VertexBuffer::isAvailable())
             {
-                //convert cropping area to target coords (remember this might not be a window!)
-                sf::Vector2f start(drawable.m_croppingWorldArea.left, drawable.m_croppingWorldArea.top);
-                sf::Vector2f end(start.x + drawable.m_croppingWorldArea.width, start.y + drawable.m_croppingWorldArea.height);
-
-                auto scissorStart = rt.mapCoordsToPixel(start);
-                auto scissorEnd = rt.mapCoordsToPixel(end);
-                //Y coords are flipped...
-                auto rtHeight = rt.getSize().y;
-                scissorStart.y = rtHeight - scissorStart.y;
-                scissorEnd.y = rtHeight - scissorEnd.y;
-
-                glScissor(scissorStart.x, scissorStart.y, scissorEnd.x - scissorStart.x, scissorEnd.y - scissorStart.y);
+                if (!chunk.uploaded)
+                {
+                    if (chunk.buffer.getVertexCount() < chunk.vertices.size())
+                    {
+                        chunk.buffer.setUsage(sf::VertexBuffer::Static);
+                        chunk.buffer.create(chunk.vertices.size());
+                    }
+                    chunk.buffer.setPrimitiveType(chunk.key.primitiveType);
+                    chunk.buffer.update(chunk.vertices.data(), chunk.vertices.size(), 0);
+                    chunk.uploaded = true;
+                }
+                rt.draw(chunk.buffer, 0, chunk.vertices.size(), states);
             }
             else
             {
-                //just set the scissor to the view
-                auto rtSize = rt.getSize();
-                glScissor(0, 0, rtSize.x, rtSize.y);
+                rt.draw(chunk.vertices.data(), chunk.vertices.size(), chunk.key.primitiveType, states);
             }
-
+        }
+        else if (batch.drawableCount == 1)
+        {
+            states.transform = batch.transform;
             rt.draw(drawable.m_vertices.data(), drawable.m_vertices.size(), drawable.m_primitiveType, states);
         }
+        else
+        {
+            //vertices are already in world space
+            states.transform = sf::Transform::Identity;
+            rt.draw(&m_batchVertices[batch.vertexStart], batch.vertexCount, drawable.m_primitiveType, states);
+        }
     }
     glDisable(GL_SCISSOR_TEST);
+
+    xy::RenderStats::addToFrame(m_stats);
 }
@@ -38,43 +38,44 @@ SpriteAnimator::SpriteAnimator(MessageBus& mb)
 {
     requireComponent<Sprite>();
     requireComponent<SpriteAnimation>();
+
+    setConcurrent(true);
 }
 
 //public
 void SpriteAnimator::process(float dt)
 {
-    auto& entities = getEntities();
-    for (auto& entity : entities) 
+    each<SpriteAnimation, Sprite>([dt](Entity, SpriteAnimation& animation, Sprite& sprite)
     {
-        auto& animation = entity.getComponent<SpriteAnimation>();
-        if (animation.m_playing)
+        if (animation.m_playing && sprite.m_animations
+            && animation.m_id < sprite.m_animations->getAnimationCount())
         {
-            auto& sprite = entity.getComponent<Sprite>();
+            const auto& anim = sprite.m_animations->getAnimation(animation.m_id);
+
             animation.m_currentFrameTime -= dt;
-            if (animation.m_currentFrameTime < 0 && sprite.m_animations[animation.m_id].frameCount > 0)
+            if (animation.m_currentFrameTime < 0 && !anim.frames.empty())
             {
-                XY_ASSERT(sprite.m_animations[animation.m_id].framerate > 0, "Illegal Frame Rate");
-                XY_ASSERT(sprite.m_animations[animation.m_id].frameCount > 0, "Illegal Frame Count");
-                animation.m_currentFrameTime += (1.f / sprite.m_animations[animation.m_id].framerate);
+                XY_ASSERT(anim.framerate > 0, "Illegal Frame Rate");
+                animation.m_currentFrameTime += (1.f / anim.framerate);
 
                 auto lastFrame = animation.m_frameID;
-                animation.m_frameID = (animation.m_frameID + 1) % sprite.m_animations[animation.m_id].frameCount;
+                animation.m_frameID = (animation.m_frameID + 1) % anim.frames.size();
 
                 if (animation.m_frameID < lastFrame)
                 {
-                    if (!sprite.m_animations[animation.m_id].looped)
+                    if (!anim.looped)
                     {
                         animation.stop();
-                        continue;
+                        return;
                     }
                     else
                     {
-                        animation.m_frameID = std::max(animation.m_frameID, sprite.m_animations[animation.m_id].loopStart);
+                        animation.m_frameID = std::max(animation.m_frameID, anim.loopStart);
                     }
                 }
 
-                sprite.setTextureRect(sprite.m_animations[animation.m_id].frames[animation.m_frameID]);
+                sprite.setTextureRect(anim.frames[animation.m_frameID]);
             }
         }
-    }
+    });
 }
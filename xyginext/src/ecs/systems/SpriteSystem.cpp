@@ -44,19 +44,18 @@ SpriteSystem::SpriteSystem(MessageBus& mb)
     //requireComponent<xy::Transform>();
     requireComponent<xy::Sprite>();
     requireComponent<xy::Drawable>();
+
+    setConcurrent(true);
 }
 
 //public
 void SpriteSystem::process(float)
 {
     //update geometry
-    auto& entities = getEntities();
-    for (auto& entity : entities)
+    each<Sprite, Drawable>([](Entity, Sprite& sprite, Drawable& drawable)
     {
-        auto& sprite = entity.getComponent<xy::Sprite>();
         if (sprite.m_dirty)
         {
-            auto& drawable = entity.getComponent<xy::Drawable>();
             //drawable.setPrimitiveType(sf::TriangleStrip);
             
             //update vert positions
@@ -86,5 +85,5 @@ void SpriteSystem::process(float)
 
             sprite.m_dirty = false;
         }
-    }
+    });
 }
@@ -39,17 +39,15 @@ TextSystem::TextSystem(xy::MessageBus& mb)
 {
     requireComponent<Drawable>();
     requireComponent<Text>();
-    requireComponent<Transform>();
+    requireComponent<Transform>(ComponentAccess::Read);
+
+    //not concurrent as updating text may load glyphs into font textures
 }
 
 void TextSystem::process(float)
 {
-    auto entities = getEntities();
-    for (auto entity : entities)
+    each<Drawable, Text>([](Entity, Drawable& drawable, Text& text)
     {
-        auto& drawable = entity.getComponent<Drawable>();
-        auto& text = entity.getComponent<Text>();
-
         if (text.m_dirty)
         {
             text.updateVertices(drawable);
@@ -57,5 +55,5 @@ void TextSystem::process(float)
             drawable.setTexture(&text.getFont()->getTexture(text.getCharacterSize()));
             drawable.setPrimitiveType(sf::PrimitiveType::Triangles);
         }
-    }
+    });
 }
\ No newline at end of file
@@ -0,0 +1,298 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include "xyginext/ecs/systems/TileMapSystem.hpp"
+#include "xyginext/ecs/components/Transform.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace xy;
+
+namespace
+{
+    //returns the texture coordinates of the given tile in TL, TR, BR, BL order
+    std::array<sf::Vector2f, 4u> getTexCoords(sf::Uint32 id, sf::Uint8 flipFlags, sf::Uint32 firstID,
+                                              sf::Uint32 columns, sf::Vector2u tileSize, sf::Uint32 margin, sf::Uint32 spacing)
+    {
+        auto index = id - firstID;
+        float left = static_cast<float>(margin + (index % columns) * (tileSize.x + spacing));
+        float top = static_cast<float>(margin + (index / columns) * (tileSize.y + spacing));
+        float right = left + tileSize.x;
+        float bottom = top + tileSize.y;
+
+        std::array<sf::Vector2f, 4u> coords =
+        {
+            sf::Vector2f(left, top), sf::Vector2f(right, top),
+            sf::Vector2f(right, bottom), sf::Vector2f(left, bottom)
+        };
+
+        //diagonal flip is applied first, as in Tiled
+        if (flipFlags & TileMapLayer::Diagonal)
+        {
+            std::swap(coords[1], coords[3]);
+        }
+        if (flipFlags & TileMapLayer::Horizontal)
+        {
+            std::swap(coords[0], coords[1]);
+            std::swap(coords[2], coords[3]);
+        }
+        if (flipFlags & TileMapLayer::Vertical)
+        {
+            std::swap(coords[0], coords[3]);
+            std::swap(coords[1], coords[2]);
+        }
+        return coords;
+    }
+}
+
+TileMapSystem::TileMapSystem(xy::MessageBus& mb)
+    : xy::System(mb, typeid(TileMapSystem))
+{
+    requireComponent<TileMapLayer>();
+    requireComponent<Transform>(ComponentAccess::Read);
+}
+
+//public
+void TileMapSystem::process(float dt)
+{
+    auto& entities = getEntities();
+    for (auto entity : entities)
+    {
+        auto& layer = entity.getComponent<TileMapLayer>();
+        for (auto& anim : layer.m_animations)
+        {
+            anim.currentTime += dt;
+            auto frame = anim.currentFrame;
+            while (anim.currentTime >= anim.frames[frame].duration)
+            {
+                if (anim.frames[frame].duration <= 0.f)
+                {
+                    anim.currentTime = 0.f;
+                    break;
+                }
+                anim.currentTime -= anim.frames[frame].duration;
+                frame = (frame + 1) % anim.frames.size();
+            }
+
+            if (frame != anim.currentFrame)
+            {
+                anim.currentFrame = frame;
+                layer.m_animationStamp++;
+            }
+        }
+    }
+}
+
+//private
+void TileMapSystem::buildChunk(TileMapLayer& layer, std::size_t chunkIndex) const
+{
+    auto& chunk = layer.m_chunks[chunkIndex];
+    chunk.tilesets.clear();
+    chunk.vertices.clear();
+    chunk.animatedTiles.clear();
+
+    const auto chunkX = static_cast<sf::Uint32>(chunkIndex % layer.m_chunkCount.x);
+    const auto chunkY = static_cast<sf::Uint32>(chunkIndex / layer.m_chunkCount.x);
+    const auto startX = chunkX * layer.m_chunkSize;
+    const auto startY = chunkY * layer.m_chunkSize;
+    const auto endX = std::min(startX + layer.m_chunkSize, layer.m_tileCount.x);
+    const auto endY = std::min(startY + layer.m_chunkSize, layer.m_tileCount.y);
+
+    for (auto y = startY; y < endY; ++y)
+    {
+        for (auto x = startX; x < endX; ++x)
+        {
+            const auto& tile = layer.m_tiles[y * layer.m_tileCount.x + x];
+            if (tile.id == 0)
+            {
+                continue;
+            }
+
+            //find the last tileset with a first ID not greater than this tile
+            auto tsResult = std::upper_bound(layer.m_tilesets.begin(), layer.m_tilesets.end(), tile.id,
+                [](sf::Uint32 id, const TileMapLayer::Tileset& ts) {return id < ts.firstID; });
+            if (tsResult == layer.m_tilesets.begin())
+            {
+                continue;
+            }
+            --tsResult;
+            const auto& tileset = *tsResult;
+            if (tile.id >= tileset.firstID + tileset.tileCount)
+            {
+                continue;
+            }
+
+            auto tilesetIndex = static_cast<std::size_t>(std::distance(layer.m_tilesets.begin(), tsResult));
+            auto arrayIndex = static_cast<std::size_t>(std::distance(chunk.tilesets.begin(),
+                                                        std::find(chunk.tilesets.begin(), chunk.tilesets.end(), tilesetIndex)));
+            if (arrayIndex == chunk.tilesets.size())
+            {
+                chunk.tilesets.push_back(tilesetIndex);
+                chunk.vertices.emplace_back();
+            }
+            auto& vertices = chunk.vertices[arrayIndex];
+
+            //tiles larger than the grid are aligned to the bottom left of the cell
+            sf::Vector2f position(x * layer.m_tileSize.x, (y + 1) * layer.m_tileSize.y - tileset.tileSize.y);
+            position += layer.m_offset;
+            sf::Vector2f size(static_cast<float>(tileset.tileSize.x), static_cast<float>(tileset.tileSize.y));
+
+            if (auto anim = layer.m_animationLookup.find(tile.id); anim != layer.m_animationLookup.end())
+            {
+                TileMapLayer::AnimatedTile animTile;
+                animTile.array = arrayIndex;
+                animTile.vertex = vertices.size();
+                animTile.animation = anim->second;
+                animTile.flipFlags = tile.flipFlags;
+                chunk.animatedTiles.push_back(animTile);
+            }
+
+            auto coords = getTexCoords(tile.id, tile.flipFlags, tileset.firstID, tileset.columns,
+                                        tileset.tileSize, tileset.margin, tileset.spacing);
+            vertices.emplace_back(position, layer.m_colour, coords[0]);
+            vertices.emplace_back(position + sf::Vector2f(size.x, 0.f), layer.m_colour, coords[1]);
+            vertices.emplace_back(position + size, layer.m_colour, coords[2]);
+            vertices.emplace_back(position + sf::Vector2f(0.f, size.y), layer.m_colour, coords[3]);
+        }
+    }
+
+    chunk.dirty = false;
+    //force animated tiles to be set to their current frame
+    chunk.animationStamp = layer.m_animationStamp - 1;
+}
+
+void TileMapSystem::updateAnimatedTiles(TileMapLayer& layer, TileMapLayer::Chunk& chunk) const
+{
+    for (const auto& animTile : chunk.animatedTiles)
+    {
+        const auto& anim = layer.m_animations[animTile.animation];
+        const auto& tileset = layer.m_tilesets[chunk.tilesets[animTile.array]];
+        auto id = anim.frames[anim.currentFrame].id;
+        if (id < tileset.firstID || id >= tileset.firstID + tileset.tileCount)
+        {
+            continue;
+        }
+
+        auto coords = getTexCoords(id, animTile.flipFlags, tileset.firstID, tileset.columns,
+                                    tileset.tileSize, tileset.margin, tileset.spacing);
+        auto* vertices = &chunk.vertices[animTile.array][animTile.vertex];
+        for (auto i = 0u; i < coords.size(); ++i)
+        {
+            vertices[i].texCoords = coords[i];
+        }
+    }
+    chunk.animationStamp = layer.m_animationStamp;
+}
+
+void TileMapSystem::draw(sf::RenderTarget& rt, sf::RenderStates states) const
+{
+    const auto& view = rt.getView();
+    sf::FloatRect viewableArea(view.getCenter() - (view.getSize() / 2.f), view.getSize());
+    if (view.getRotation() != 0.f)
+    {
+        viewableArea = view.getTransform().getInverse().transformRect({ -1.f, -1.f, 2.f, 2.f });
+    }
+
+    RenderStats stats;
+    const sf::Texture* previousTexture = nullptr;
+    const auto baseTransform = states.transform;
+
+    const auto& entities = getEntities();
+    for (auto entity : entities)
+    {
+        auto& layer = entity.getComponent<TileMapLayer>();
+        if (layer.m_chunks.empty())
+        {
+            continue;
+        }
+
+        const auto& tx = entity.getComponent<Transform>();
+        states.transform = baseTransform * tx.getWorldTransform();
+
+        //find the view area in the layer's local space. Tiles larger than
+        //the grid overlap the chunk to their right and the chunk above, so
+        //pad the area by the largest tile size to the left and below
+        auto localArea = states.transform.getInverse().transformRect(viewableArea);
+        localArea.left -= (layer.m_offset.x + layer.m_maxTileSize.x);
+        localArea.top -= layer.m_offset.y;
+        localArea.width += layer.m_maxTileSize.x;
+        localArea.height += layer.m_maxTileSize.y;
+
+        const sf::Vector2f chunkSize(layer.m_tileSize.x * layer.m_chunkSize, layer.m_tileSize.y * layer.m_chunkSize);
+        const auto maxX = static_cast<float>(layer.m_chunkCount.x);
+        const auto maxY = static_cast<float>(layer.m_chunkCount.y);
+        const auto startX = static_cast<sf::Uint32>(std::clamp(std::floor(localArea.left / chunkSize.x), 0.f, maxX));
+        const auto startY = static_cast<sf::Uint32>(std::clamp(std::floor(localArea.top / chunkSize.y), 0.f, maxY));
+        const auto endX = static_cast<sf::Uint32>(std::clamp(std::ceil((localArea.left + localArea.width) / chunkSize.x), 0.f, maxX));
+        const auto endY = static_cast<sf::Uint32>(std::clamp(std::ceil((localArea.top + localArea.height) / chunkSize.y), 0.f, maxY));
+
+        std::size_t visibleCount = 0;
+        for (auto y = startY; y < endY; ++y)
+        {
+            for (auto x = startX; x < endX; ++x)
+            {
+                auto chunkIndex = y * layer.m_chunkCount.x + x;
+                auto& chunk = layer.m_chunks[chunkIndex];
+                if (chunk.dirty)
+                {
+                    buildChunk(layer, chunkIndex);
+                }
+
+                if (chunk.animationStamp != layer.m_animationStamp)
+                {
+                    updateAnimatedTiles(layer, chunk);
+                }
+
+                for (auto i = 0u; i < chunk.vertices.size(); ++i)
+                {
+                    states.texture = layer.m_tilesets[chunk.tilesets[i]].texture;
+                    rt.draw(chunk.vertices[i].data(), chunk.vertices[i].size(), sf::Quads, states);
+
+                    stats.drawCalls++;
+                    stats.vertexCount += chunk.vertices[i].size();
+                    if (states.texture != previousTexture)
+                    {
+                        stats.textureChanges++;
+                        previousTexture = states.texture;
+                    }
+                }
+                visibleCount++;
+            }
+        }
+        stats.drawablesDrawn += visibleCount;
+        stats.drawablesCulled += layer.m_chunks.size() - visibleCount;
+    }
+
+    RenderStats::addToFrame(stats);
+}
@@ -0,0 +1,228 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include "xyginext/ecs/systems/TransformSystem.hpp"
+#include "xyginext/ecs/components/Transform.hpp"
+#include "xyginext/core/JobSystem.hpp"
+#include "xyginext/util/Const.hpp"
+
+#include <cmath>
+
+using namespace xy;
+
+namespace
+{
+    const std::size_t TransformsPerJob = 1024;
+}
+
+TransformSystem::TransformSystem(MessageBus& mb)
+    : System            (mb, typeid(TransformSystem)),
+    m_hierarchyVersion  (0),
+    m_rebuild           (true)
+{
+    requireComponent<Transform>();
+
+    setConcurrent(true);
+}
+
+//public
+void TransformSystem::process(float)
+{
+    if (m_rebuild || m_hierarchyVersion != Transform::getHierarchyVersion())
+    {
+        rebuild();
+    }
+
+    //clean transforms already have a valid world matrix, as do all their parents
+    m_dirtyIndices.clear();
+    for (auto i = 0u; i < m_transforms.size(); ++i)
+    {
+        if (m_transforms[i]->m_worldState.load(std::memory_order_relaxed) != Transform::Clean)
+        {
+            m_dirtyIndices.push_back(i);
+        }
+    }
+
+    if (m_dirtyIndices.empty())
+    {
+        return;
+    }
+
+    const auto dirtyCount = m_dirtyIndices.size();
+    m_l00.resize(dirtyCount);
+    m_l01.resize(dirtyCount);
+    m_l02.resize(dirtyCount);
+    m_l10.resize(dirtyCount);
+    m_l11.resize(dirtyCount);
+    m_l12.resize(dirtyCount);
+
+    JobSystem::parallelFor("xy::TransformSystem", dirtyCount, TransformsPerJob,
+        [this](std::size_t begin, std::size_t end)
+    {
+        calcLocalTransforms(begin, end);
+    });
+
+    calcWorldTransforms();
+
+    //write the results back to the transform caches
+    JobSystem::parallelFor("xy::TransformSystem", dirtyCount, TransformsPerJob,
+        [this](std::size_t begin, std::size_t end)
+    {
+        for (auto j = begin; j < end; ++j)
+        {
+            const auto i = m_dirtyIndices[j];
+            auto* tx = m_transforms[i];
+            tx->m_worldTransform = sf::Transform(m_w00[i], m_w01[i], m_w02[i],
+                                                m_w10[i], m_w11[i], m_w12[i],
+                                                0.f, 0.f, 1.f);
+            tx->m_worldState.store(Transform::Clean, std::memory_order_release);
+            m_updated[i] = 0;
+        }
+    });
+}
+
+//private
+void TransformSystem::rebuild()
+{
+    m_transforms.clear();
+    m_parents.clear();
+
+    //add all the root transforms, then each level of their children
+    //in turn, so that transforms are sorted by depth
+    for (auto entity : getEntities())
+    {
+        auto& tx = entity.getComponent<Transform>();
+        if (tx.m_parent == nullptr)
+        {
+            m_transforms.push_back(&tx);
+            m_parents.push_back(NoParent);
+        }
+    }
+
+    for (auto i = 0u; i < m_transforms.size(); ++i)
+    {
+        const auto& children = m_transforms[i]->m_children;
+        for (auto* child : children)
+        {
+            m_transforms.push_back(child);
+            m_parents.push_back(static_cast<sf::Uint32>(i));
+        }
+    }
+
+    const auto count = m_transforms.size();
+    m_updated.assign(count, 0);
+    m_w00.resize(count);
+    m_w01.resize(count);
+    m_w02.resize(count);
+    m_w10.resize(count);
+    m_w11.resize(count);
+    m_w12.resize(count);
+
+    m_hierarchyVersion = Transform::getHierarchyVersion();
+    m_rebuild = false;
+}
+
+void TransformSystem::calcLocalTransforms(std::size_t begin, std::size_t end)
+{
+    //this is the same as sf::Transformable::getTransform(), but without touching
+    //the transformable's cache, and laid out so the compiler can vectorise it
+    for (auto j = begin; j < end; ++j)
+    {
+        const auto* tx = m_transforms[m_dirtyIndices[j]];
+        const auto& scale = tx->getScale();
+        const auto& origin = tx->getOrigin();
+        const auto& position = tx->getPosition();
+
+        const float angle = -tx->getRotation() * Util::Const::degToRad;
+        const float cosine = std::cos(angle);
+        const float sine = std::sin(angle);
+
+        const float sxc = scale.x * cosine;
+        const float syc = scale.y * cosine;
+        const float sxs = scale.x * sine;
+        const float sys = scale.y * sine;
+
+        m_l00[j] = sxc;
+        m_l01[j] = sys;
+        m_l02[j] = -origin.x * sxc - origin.y * sys + position.x;
+        m_l10[j] = -sxs;
+        m_l11[j] = syc;
+        m_l12[j] = origin.x * sxs - origin.y * syc + position.y;
+    }
+}
+
+void TransformSystem::calcWorldTransforms()
+{
+    //dirty indices are sorted by depth, so any dirty parent
+    //has already been updated by the time we reach its children
+    for (auto j = 0u; j < m_dirtyIndices.size(); ++j)
+    {
+        const auto i = m_dirtyIndices[j];
+        const auto parent = m_parents[i];
+
+        if (parent == NoParent)
+        {
+            m_w00[i] = m_l00[j]; m_w01[i] = m_l01[j]; m_w02[i] = m_l02[j];
+            m_w10[i] = m_l10[j]; m_w11[i] = m_l11[j]; m_w12[i] = m_l12[j];
+        }
+        else
+        {
+            float p00, p01, p02, p10, p11, p12;
+            if (m_updated[parent])
+            {
+                p00 = m_w00[parent]; p01 = m_w01[parent]; p02 = m_w02[parent];
+                p10 = m_w10[parent]; p11 = m_w11[parent]; p12 = m_w12[parent];
+            }
+            else
+            {
+                //parent is clean so read its cached matrix
+                const float* m = m_transforms[parent]->m_worldTransform.getMatrix();
+                p00 = m[0]; p01 = m[4]; p02 = m[12];
+                p10 = m[1]; p11 = m[5]; p12 = m[13];
+            }
+
+            m_w00[i] = p00 * m_l00[j] + p01 * m_l10[j];
+            m_w01[i] = p00 * m_l01[j] + p01 * m_l11[j];
+            m_w02[i] = p00 * m_l02[j] + p01 * m_l12[j] + p02;
+            m_w10[i] = p10 * m_l00[j] + p11 * m_l10[j];
+            m_w11[i] = p10 * m_l01[j] + p11 * m_l11[j];
+            m_w12[i] = p10 * m_l02[j] + p11 * m_l12[j] + p12;
+        }
+        m_updated[i] = 1;
+    }
+}
+
+void TransformSystem::onEntityAdded(Entity)
+{
+    m_rebuild = true;
+}
+
+void TransformSystem::onEntityRemoved(Entity)
+{
+    m_rebuild = true;
+}
@@ -58,6 +58,9 @@ UISystem::UISystem(MessageBus& mb)
     requireComponent<UIHitBox>();
     requireComponent<Transform>();
 
+    //inputs are selected by their index
+    setStableRemoval(true);
+
     //default callbacks for components which don't have one assigned
     m_buttonCallbacks.push_back([](Entity, sf::Uint64) {}); 
     m_movementCallbacks.push_back([](Entity, sf::Vector2f) {});
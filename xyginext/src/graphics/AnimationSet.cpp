@@ -0,0 +1,64 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include "xyginext/graphics/AnimationSet.hpp"
+#include "xyginext/core/Assert.hpp"
+
+#include <algorithm>
+
+using namespace xy;
+
+std::size_t AnimationSet::addAnimation(const Animation& animation)
+{
+    m_animations.push_back(animation);
+    return m_animations.size() - 1;
+}
+
+const AnimationSet::Animation& AnimationSet::getAnimation(std::size_t index) const
+{
+    XY_ASSERT(index < m_animations.size(), "Index out of range");
+    return m_animations[index];
+}
+
+AnimationSet::Animation& AnimationSet::getAnimation(std::size_t index)
+{
+    XY_ASSERT(index < m_animations.size(), "Index out of range");
+    return m_animations[index];
+}
+
+std::size_t AnimationSet::getAnimationIndex(const std::string& id) const
+{
+    auto result = std::find_if(m_animations.cbegin(), m_animations.cend(),
+        [&id](const Animation& anim) {return anim.id == id; });
+
+    if (result == m_animations.cend())
+    {
+        return 0;
+    }
+    return std::distance(m_animations.cbegin(), result);
+}
@@ -0,0 +1,209 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include "xyginext/graphics/Material.hpp"
+#include "xyginext/core/Assert.hpp"
+
+#include "../detail/GLCheck.hpp"
+
+#include <SFML/Graphics/Glsl.hpp>
+#include <SFML/Graphics/Shader.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace xy;
+
+namespace
+{
+    //stamp of the last material applied to each program
+    std::unordered_map<GLuint, std::uint64_t> programStamps;
+    std::uint64_t nextStamp = 0;
+}
+
+Material::Material()
+    : m_shader      (nullptr),
+    m_applyStamp    (0)
+{
+
+}
+
+Material::Material(sf::Shader& shader)
+    : m_shader      (&shader),
+    m_applyStamp    (0)
+{
+
+}
+
+//public
+void Material::setShader(sf::Shader* shader)
+{
+    if (shader != m_shader)
+    {
+        m_shader = shader;
+        m_applyStamp = 0;
+        for (auto& uniform : m_uniforms)
+        {
+            uniform.location = Unresolved;
+            uniform.dirty = true;
+        }
+    }
+}
+
+void Material::setUniform(const std::string& name, float value)
+{
+    getUniform(name, UniformType::Float).values[0] = value;
+}
+
+void Material::setUniform(const std::string& name, sf::Vector2f value)
+{
+    auto& uniform = getUniform(name, UniformType::Vec2);
+    uniform.values[0] = value.x;
+    uniform.values[1] = value.y;
+}
+
+void Material::setUniform(const std::string& name, sf::Vector3f value)
+{
+    auto& uniform = getUniform(name, UniformType::Vec3);
+    uniform.values[0] = value.x;
+    uniform.values[1] = value.y;
+    uniform.values[2] = value.z;
+}
+
+void Material::setUniform(const std::string& name, bool value)
+{
+    getUniform(name, UniformType::Bool).values[0] = value ? 1.f : 0.f;
+}
+
+void Material::setUniform(const std::string& name, sf::Color colour)
+{
+    const sf::Glsl::Vec4 value(colour);
+    auto& uniform = getUniform(name, UniformType::Colour);
+    uniform.values = { value.x, value.y, value.z, value.w };
+}
+
+void Material::setUniform(const std::string& name, const sf::Texture& texture)
+{
+    getUniform(name, UniformType::Texture).pointer = &texture;
+}
+
+void Material::setUniform(const std::string& name, const float* matrix)
+{
+    getUniform(name, UniformType::Matrix).pointer = matrix;
+}
+
+void Material::setUniformToCurrentTexture(const std::string& name)
+{
+    getUniform(name, UniformType::CurrentTexture);
+}
+
+void Material::apply() const
+{
+    XY_ASSERT(m_shader, "No shader set!");
+
+    //the program is bound by the caller. It keeps the values uploaded to it, so
+    //if this was the last material applied only changed values need uploading
+    const auto program = static_cast<GLuint>(m_shader->getNativeHandle());
+    auto& programStamp = programStamps[program];
+    const bool uploadAll = (m_applyStamp == 0 || m_applyStamp != programStamp);
+    m_applyStamp = programStamp = ++nextStamp;
+
+    for (const auto& uniform : m_uniforms)
+    {
+        //matrices are read through a pointer so may have changed at any time
+        if (!uploadAll && !uniform.dirty && uniform.type != UniformType::Matrix)
+        {
+            continue;
+        }
+        uniform.dirty = false;
+
+        if (uniform.location == Unresolved)
+        {
+            uniform.location = glGetUniformLocation(program, uniform.name.c_str());
+        }
+
+        if (uniform.location == -1)
+        {
+            continue;
+        }
+
+        //textures are bound by SFML when it binds the shader, so are set via
+        //the shader. Everything else is set directly on the program
+        const auto& v = uniform.values;
+        switch (uniform.type)
+        {
+        default: break;
+        case UniformType::Float:
+            glCheck(glUniform1f(uniform.location, v[0]));
+            break;
+        case UniformType::Vec2:
+            glCheck(glUniform2f(uniform.location, v[0], v[1]));
+            break;
+        case UniformType::Vec3:
+            glCheck(glUniform3f(uniform.location, v[0], v[1], v[2]));
+            break;
+        case UniformType::Bool:
+            glCheck(glUniform1i(uniform.location, v[0] != 0.f ? 1 : 0));
+            break;
+        case UniformType::Colour:
+            glCheck(glUniform4f(uniform.location, v[0], v[1], v[2], v[3]));
+            break;
+        case UniformType::Matrix:
+            glCheck(glUniformMatrix4fv(uniform.location, 1, GL_FALSE, static_cast<const float*>(uniform.pointer)));
+            break;
+        case UniformType::Texture:
+            m_shader->setUniform(uniform.name, *static_cast<const sf::Texture*>(uniform.pointer));
+            break;
+        case UniformType::CurrentTexture:
+            m_shader->setUniform(uniform.name, sf::Shader::CurrentTexture);
+            break;
+        }
+    }
+}
+
+//private
+Material::Uniform& Material::getUniform(const std::string& name, UniformType type)
+{
+    auto result = std::find_if(m_uniforms.begin(), m_uniforms.end(),
+        [&name](const Uniform& uniform)
+    {
+        return uniform.name == name;
+    });
+
+    if (result == m_uniforms.end())
+    {
+        auto& uniform = m_uniforms.emplace_back();
+        uniform.name = name;
+        uniform.type = type;
+        return uniform;
+    }
+
+    result->type = type;
+    result->dirty = true;
+    return *result;
+}
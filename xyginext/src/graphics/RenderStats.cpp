@@ -0,0 +1,77 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include "xyginext/graphics/RenderStats.hpp"
+
+using namespace xy;
+
+RenderStats RenderStats::m_currentFrame;
+std::array<RenderStats, RenderStats::HistorySize> RenderStats::m_history = {};
+std::size_t RenderStats::m_historyIndex = 0;
+
+RenderStats& RenderStats::operator += (const RenderStats& other)
+{
+    drawCalls += other.drawCalls;
+    vertexCount += other.vertexCount;
+    drawablesDrawn += other.drawablesDrawn;
+    drawablesCulled += other.drawablesCulled;
+    batchedDrawables += other.batchedDrawables;
+    textureChanges += other.textureChanges;
+    shaderChanges += other.shaderChanges;
+    blendModeChanges += other.blendModeChanges;
+    scissorChanges += other.scissorChanges;
+    renderTargetChanges += other.renderTargetChanges;
+    return *this;
+}
+
+void RenderStats::addToFrame(const RenderStats& stats)
+{
+    m_currentFrame += stats;
+}
+
+const RenderStats& RenderStats::getLastFrame()
+{
+    return m_history[(m_historyIndex + HistorySize - 1) % HistorySize];
+}
+
+const std::array<RenderStats, RenderStats::HistorySize>& RenderStats::getHistory()
+{
+    return m_history;
+}
+
+std::size_t RenderStats::getHistoryOffset()
+{
+    return m_historyIndex;
+}
+
+void RenderStats::endFrame()
+{
+    m_history[m_historyIndex] = m_currentFrame;
+    m_historyIndex = (m_historyIndex + 1) % HistorySize;
+    m_currentFrame = {};
+}
@@ -71,17 +71,16 @@ bool SpriteSheet::saveToFile(const std::string &path)
         sprObj->addProperty("bounds").setValue(sprite.second.getTextureRect());
         sprObj->addProperty("colour").setValue(sprite.second.getColour());
         
-        auto& anims = sprite.second.getAnimations();
-        for (auto i(0u); i < sprite.second.getAnimationCount(); i++)
+        const auto& anims = sprite.second.getAnimations();
+        for (const auto& anim : anims)
         {
-            auto animObj = sprObj->addObject("animation", m_animations[sprite.first][i]);
-            animObj->addProperty("framerate").setValue(anims[i].framerate);
-            animObj->addProperty("loop").setValue(anims[i].looped);
+            auto animObj = sprObj->addObject("animation", anim.id);
+            animObj->addProperty("framerate").setValue(anim.framerate);
+            animObj->addProperty("loop").setValue(anim.looped);
             
-            auto& frames = anims[i].frames;
-            for (auto j(0u); j < anims[i].frameCount; j++)
+            for (const auto& frame : anim.frames)
             {
-                animObj->addProperty("frame").setValue(frames[j]);
+                animObj->addProperty("frame").setValue(frame);
             }
         }
     }
@@ -126,13 +125,10 @@ const std::unordered_map<std::string, Sprite>& SpriteSheet::getSprites() const
 
 std::size_t SpriteSheet::getAnimationIndex(const std::string& name, const std::string& spriteName) const
 {
-    if (m_animations.count(spriteName) != 0)
+    if (auto result = m_sprites.find(spriteName); result != m_sprites.end()
+        && result->second.getAnimationSet())
     {
-        const auto& anims = m_animations[spriteName];
-        const auto& result = std::find(anims.cbegin(), anims.cend(), name);
-        if (result == anims.cend()) return 0;
-
-        return std::distance(anims.cbegin(), result);
+        return result->second.getAnimationSet()->getAnimationIndex(name);
     }
     return 0;
 }
@@ -148,7 +144,6 @@ bool SpriteSheet::loadFromFile(const std::string& path, std::function<sf::Textur
     }
 
     m_sprites.clear();
-    m_animations.clear();
 
     std::size_t count = 0;
 
@@ -221,12 +216,15 @@ bool SpriteSheet::loadFromFile(const std::string& path, std::function<sf::Textur
                 spriteComponent.setColour(p->getValue<sf::Color>());
             }
 
+            //animations are created once here and shared by all copies of the sprite
+            auto animations = std::make_shared<AnimationSet>();
             const auto& spriteObjs = spr.getObjects();
             for (const auto& sprOb : spriteObjs)
             {
                 if (sprOb.getName() == "animation")
                 {
-                    auto& anim = spriteComponent.m_animations[spriteComponent.m_animationCount];
+                    AnimationSet::Animation anim;
+                    anim.id = sprOb.getId();
 
                     const auto& properties = sprOb.getProperties();
                     for (const auto& p : properties)
@@ -234,7 +232,7 @@ bool SpriteSheet::loadFromFile(const std::string& path, std::function<sf::Textur
                         std::string name = p.getName();
                         if (name == "frame")
                         {
-                            anim.frames[anim.frameCount++] = p.getValue<sf::FloatRect>();
+                            anim.frames.push_back(p.getValue<sf::FloatRect>());
                         }
                         else if (name == "framerate")
                         {
@@ -246,14 +244,15 @@ bool SpriteSheet::loadFromFile(const std::string& path, std::function<sf::Textur
                         }
                     }
 
-                    auto animId = sprOb.getId();
-                    m_animations[spriteName].push_back(animId);
-                    animId.copy(anim.id.data(), animId.length());
-
-                    spriteComponent.m_animationCount++;
+                    animations->addAnimation(anim);
                 }
             }
 
+            if (animations->getAnimationCount() > 0)
+            {
+                spriteComponent.setAnimationSet(animations);
+            }
+
             m_sprites.insert(std::make_pair(spriteName, spriteComponent));
             count++;
         }
@@ -261,4 +260,35 @@ bool SpriteSheet::loadFromFile(const std::string& path, std::function<sf::Textur
 
     //LOG("Found " + std::to_string(count) + " sprites in " + path, Logger::Type::Info);
     return count > 0;
-}
\ No newline at end of file
+}
+
+void SpriteSheet::setAtlasTexture(const sf::Texture& texture, sf::Vector2f offset)
+{
+    auto move = [offset](sf::FloatRect rect)
+    {
+        rect.left += offset.x;
+        rect.top += offset.y;
+        return rect;
+    };
+
+    for (auto& [name, sprite] : m_sprites)
+    {
+        const auto rect = sprite.getTextureRect();
+        sprite.setTexture(texture);
+        sprite.setTextureRect(move(rect));
+
+        //sprites already taken from the sheet keep the original set
+        if (sprite.getAnimationSet())
+        {
+            auto animations = std::make_shared<AnimationSet>(*sprite.getAnimationSet());
+            for (auto i = 0u; i < animations->getAnimationCount(); ++i)
+            {
+                for (auto& frame : animations->getAnimation(i).frames)
+                {
+                    frame = move(frame);
+                }
+            }
+            sprite.setAnimationSet(animations);
+        }
+    }
+}
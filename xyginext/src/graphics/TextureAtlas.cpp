@@ -0,0 +1,349 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include "xyginext/graphics/TextureAtlas.hpp"
+#include "xyginext/graphics/SpriteSheet.hpp"
+#include "xyginext/core/ConfigFile.hpp"
+#include "xyginext/core/FileSystem.hpp"
+#include "xyginext/core/Log.hpp"
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <algorithm>
+#include <limits>
+
+//imgui's copy of the implementation is static to imgui_draw.cpp
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "../imgui/imstb_rectpack.h"
+
+using namespace xy;
+
+namespace
+{
+    const sf::Uint32 DefaultPageSize = 2048;
+    const sf::Uint32 DefaultPadding = 2;
+}
+
+TextureAtlas::TextureAtlas()
+    : m_pageSize(DefaultPageSize, DefaultPageSize),
+    m_padding   (DefaultPadding),
+    m_smooth    (false)
+{
+
+}
+
+//public
+void TextureAtlas::setPageSize(sf::Vector2u size)
+{
+    XY_ASSERT(size.x > 0 && size.y > 0, "Invalid page size");
+
+    //rect pack coordinates are 16 bit, and pages must fit in a texture
+    const auto maxSize = std::min(static_cast<sf::Uint32>(std::numeric_limits<stbrp_coord>::max()), sf::Texture::getMaximumSize());
+    if (size.x > maxSize || size.y > maxSize)
+    {
+        size.x = std::min(size.x, maxSize);
+        size.y = std::min(size.y, maxSize);
+        Logger::log("Texture atlas page size clamped to " + std::to_string(size.x) + "x" + std::to_string(size.y), Logger::Type::Warning);
+    }
+
+    if (size != m_pageSize)
+    {
+        m_pageSize = size;
+        m_placements.clear();
+    }
+}
+
+void TextureAtlas::setPadding(sf::Uint32 padding)
+{
+    if (padding != m_padding)
+    {
+        m_padding = padding;
+        m_placements.clear();
+    }
+}
+
+void TextureAtlas::setSmooth(bool smooth)
+{
+    m_smooth = smooth;
+    for (auto& page : m_pages)
+    {
+        page->setSmooth(smooth);
+    }
+}
+
+void TextureAtlas::addSpriteSheet(SpriteSheet& sheet)
+{
+    if (std::find(m_spriteSheets.begin(), m_spriteSheets.end(), &sheet) == m_spriteSheets.end())
+    {
+        m_spriteSheets.push_back(&sheet);
+    }
+}
+
+bool TextureAtlas::build()
+{
+    //load each source image once, no matter how many sheets share it
+    std::unordered_map<std::string, sf::Image> images;
+    for (const auto* sheet : m_spriteSheets)
+    {
+        const auto& path = sheet->getTexturePath();
+        if (images.count(path) == 0)
+        {
+            sf::Image image;
+            if (image.loadFromFile(xy::FileSystem::getResourcePath() + path))
+            {
+                images.insert(std::make_pair(path, std::move(image)));
+            }
+            else
+            {
+                Logger::log("Texture atlas failed to load " + path, Logger::Type::Error);
+            }
+        }
+    }
+
+    auto fitsPage = [&](const sf::Image& image)
+    {
+        const auto size = image.getSize();
+        return size.x + m_padding <= m_pageSize.x && size.y + m_padding <= m_pageSize.y;
+    };
+
+    //use the loaded placement if it matches every image, else repack
+    bool usePlacement = !m_placements.empty();
+    for (const auto& [path, image] : images)
+    {
+        if (!fitsPage(image))
+        {
+            continue;
+        }
+
+        auto result = m_placements.find(path);
+        if (result == m_placements.end()
+            || result->second.bounds.left < 0 || result->second.bounds.top < 0
+            || result->second.bounds.width != static_cast<int>(image.getSize().x)
+            || result->second.bounds.height != static_cast<int>(image.getSize().y)
+            || static_cast<sf::Uint32>(result->second.bounds.left) + image.getSize().x > m_pageSize.x
+            || static_cast<sf::Uint32>(result->second.bounds.top) + image.getSize().y > m_pageSize.y)
+        {
+            usePlacement = false;
+            break;
+        }
+    }
+
+    if (usePlacement)
+    {
+        //drop placements of images which failed to load, are too
+        //large, or don't belong to any of the sheets being built
+        for (auto it = m_placements.begin(); it != m_placements.end();)
+        {
+            auto image = images.find(it->first);
+            if (image == images.end() || !fitsPage(image->second))
+            {
+                it = m_placements.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    if (!usePlacement)
+    {
+        m_placements.clear();
+
+        std::vector<std::string> paths;
+        std::vector<stbrp_rect> rects;
+        for (const auto& [path, image] : images)
+        {
+            if (!fitsPage(image))
+            {
+                LOG(path + " is too large to fit in texture atlas", Logger::Type::Warning);
+                continue;
+            }
+
+            const auto size = image.getSize();
+            stbrp_rect rect;
+            rect.id = static_cast<int>(paths.size());
+            rect.w = static_cast<stbrp_coord>(size.x + m_padding);
+            rect.h = static_cast<stbrp_coord>(size.y + m_padding);
+            rects.push_back(rect);
+            paths.push_back(path);
+        }
+
+        //fill one page at a time with whatever is left over from the previous page
+        std::vector<stbrp_node> nodes(m_pageSize.x);
+        std::size_t page = 0;
+        while (!rects.empty())
+        {
+            stbrp_context context;
+            stbrp_init_target(&context, m_pageSize.x, m_pageSize.y, nodes.data(), static_cast<int>(nodes.size()));
+            stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size()));
+
+            for (const auto& rect : rects)
+            {
+                if (rect.was_packed)
+                {
+                    const auto& size = images[paths[rect.id]].getSize();
+
+                    Placement placement;
+                    placement.page = page;
+                    placement.bounds = { rect.x, rect.y, static_cast<int>(size.x), static_cast<int>(size.y) };
+                    m_placements.insert(std::make_pair(paths[rect.id], placement));
+                }
+            }
+
+            rects.erase(std::remove_if(rects.begin(), rects.end(),
+                [](const stbrp_rect& rect)
+            {
+                return rect.was_packed != 0;
+            }), rects.end());
+
+            page++;
+        }
+    }
+
+    //pages only need to be as large as the area used
+    std::vector<sf::Vector2u> pageSizes;
+    for (const auto& [path, placement] : m_placements)
+    {
+        if (placement.page >= pageSizes.size())
+        {
+            pageSizes.resize(placement.page + 1);
+        }
+        auto& size = pageSizes[placement.page];
+        size.x = std::max(size.x, static_cast<sf::Uint32>(placement.bounds.left + placement.bounds.width));
+        size.y = std::max(size.y, static_cast<sf::Uint32>(placement.bounds.top + placement.bounds.height));
+    }
+
+    std::vector<sf::Image> pageImages(pageSizes.size());
+    for (auto i = 0u; i < pageSizes.size(); ++i)
+    {
+        pageImages[i].create(std::max(1u, pageSizes[i].x), std::max(1u, pageSizes[i].y), sf::Color::Transparent);
+    }
+
+    for (const auto& [path, placement] : m_placements)
+    {
+        pageImages[placement.page].copy(images.at(path), placement.bounds.left, placement.bounds.top);
+    }
+
+    m_pages.clear();
+    for (const auto& image : pageImages)
+    {
+        auto& texture = m_pages.emplace_back(std::make_unique<sf::Texture>());
+        texture->loadFromImage(image);
+        texture->setSmooth(m_smooth);
+    }
+
+    //point the sprite sheets at the atlas
+    bool moved = false;
+    for (auto* sheet : m_spriteSheets)
+    {
+        auto result = m_placements.find(sheet->getTexturePath());
+        if (result != m_placements.end())
+        {
+            const auto& placement = result->second;
+            sheet->setAtlasTexture(*m_pages[placement.page],
+                { static_cast<float>(placement.bounds.left), static_cast<float>(placement.bounds.top) });
+            moved = true;
+        }
+    }
+    m_spriteSheets.clear();
+
+    return moved;
+}
+
+const sf::Texture& TextureAtlas::getPage(std::size_t index) const
+{
+    XY_ASSERT(index < m_pages.size(), "Index out of range");
+    return *m_pages[index];
+}
+
+bool TextureAtlas::loadFromFile(const std::string& path)
+{
+    m_placements.clear();
+
+    ConfigFile atlasFile;
+    if (!atlasFile.loadFromFile(path))
+    {
+        return false;
+    }
+
+    if (auto* p = atlasFile.findProperty("page_size");
+        !p || p->getValue<sf::Vector2u>() != m_pageSize)
+    {
+        return false;
+    }
+
+    if (auto* p = atlasFile.findProperty("padding");
+        !p || static_cast<sf::Uint32>(p->getValue<sf::Int32>()) != m_padding)
+    {
+        return false;
+    }
+
+    const auto& objects = atlasFile.getObjects();
+    for (const auto& obj : objects)
+    {
+        if (obj.getName() == "image")
+        {
+            const auto* src = obj.findProperty("src");
+            const auto* page = obj.findProperty("page");
+            const auto* bounds = obj.findProperty("bounds");
+            if (!src || !page || !bounds)
+            {
+                Logger::log(path + ": invalid image entry in texture atlas", Logger::Type::Error);
+                m_placements.clear();
+                return false;
+            }
+
+            Placement placement;
+            placement.page = static_cast<std::size_t>(page->getValue<sf::Int32>());
+            placement.bounds = static_cast<sf::IntRect>(bounds->getValue<sf::FloatRect>());
+            m_placements.insert(std::make_pair(src->getValue<std::string>(), placement));
+        }
+    }
+
+    return !m_placements.empty();
+}
+
+bool TextureAtlas::saveToFile(const std::string& path) const
+{
+    ConfigFile atlasFile("texture_atlas");
+    atlasFile.addProperty("page_size").setValue(m_pageSize);
+    atlasFile.addProperty("padding").setValue(static_cast<sf::Int32>(m_padding));
+
+    auto i = 0;
+    for (const auto& [src, placement] : m_placements)
+    {
+        auto* obj = atlasFile.addObject("image", std::to_string(i++));
+        obj->addProperty("src", "\"" + src + "\"");
+        obj->addProperty("page").setValue(static_cast<sf::Int32>(placement.page));
+        obj->addProperty("bounds").setValue(static_cast<sf::FloatRect>(placement.bounds));
+    }
+
+    return atlasFile.save(path);
+}
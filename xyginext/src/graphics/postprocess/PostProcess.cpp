@@ -26,6 +26,7 @@ source distribution.
 *********************************************************************/
 
 #include "xyginext/graphics/postprocess/PostProcess.hpp"
+#include "xyginext/graphics/RenderStats.hpp"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Shader.hpp>
@@ -67,6 +68,13 @@ void PostProcess::applyShader(const sf::Shader& shader, sf::RenderTarget& dest)
     states.blendMode = sf::BlendNone;
 
     dest.draw(vertexArray.data(), vertexArray.size(), sf::Quads, states);
+
+    RenderStats stats;
+    stats.drawCalls = 1;
+    stats.vertexCount = vertexArray.size();
+    stats.shaderChanges = 1;
+    stats.blendModeChanges = 1;
+    RenderStats::addToFrame(stats);
 }
 
 void PostProcess::resizeBuffer(sf::Int32 w, sf::Int32 h)
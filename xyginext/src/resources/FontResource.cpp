@@ -28,6 +28,7 @@ source distribution.
 //creates a default font in memory to return when requested font unavailable//
 #include "xyginext/resources/Resource.hpp"
 #include "xyginext/resources/SystemFont.hpp"
+#include "xyginext/ecs/components/Text.hpp"
 
 using namespace xy;
 
@@ -57,6 +58,12 @@ FontResource::FontResource()
     }
 }
 
+FontResource::~FontResource()
+{
+    //cached text layouts refer to fonts by address
+    Text::clearGlyphCache();
+}
+
 std::unique_ptr<sf::Font> FontResource::errorHandle()
 {
 	return std::make_unique<sf::Font>(m_font);
@@ -0,0 +1,472 @@
+/*********************************************************************
+(c) Matt Marchant 2017 - 2019
+http://trederia.blogspot.com
+
+xygineXT - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+/*
+Based on the dynamic AABB tree found in Box2D by Erin Catto http://www.box2d.org
+*/
+
+#include "xyginext/util/DynamicTree.hpp"
+#include "xyginext/core/Assert.hpp"
+
+#include <algorithm>
+
+using namespace xy;
+
+namespace
+{
+    const std::size_t InitialCapacity = 16;
+    const float DisplacementMultiplier = 2.f;
+
+    template <typename T>
+    T combine(const T& a, const T& b)
+    {
+        T result;
+        result.left = std::min(a.left, b.left);
+        result.top = std::min(a.top, b.top);
+        result.right = std::max(a.right, b.right);
+        result.bottom = std::max(a.bottom, b.bottom);
+        return result;
+    }
+
+    template <typename T>
+    float perimeter(const T& bounds)
+    {
+        return 2.f * ((bounds.right - bounds.left) + (bounds.bottom - bounds.top));
+    }
+
+    template <typename T>
+    bool contains(const T& outer, const T& inner)
+    {
+        return outer.left <= inner.left && outer.top <= inner.top
+            && inner.right <= outer.right && inner.bottom <= outer.bottom;
+    }
+
+    template <typename T>
+    bool overlaps(const T& a, const T& b)
+    {
+        return a.left <= b.right && b.left <= a.right
+            && a.top <= b.bottom && b.top <= a.bottom;
+    }
+}
+
+DynamicTree::DynamicTree(float margin)
+    : m_margin  (margin),
+    m_root      (NullNode),
+    m_freeList  (NullNode),
+    m_proxyCount(0)
+{
+    XY_ASSERT(margin >= 0.f, "Margin must not be negative");
+    m_nodes.reserve(InitialCapacity);
+}
+
+//public
+std::int32_t DynamicTree::addProxy(sf::FloatRect rect, std::uint32_t userData)
+{
+    auto proxyID = allocateNode();
+
+    auto& node = m_nodes[proxyID];
+    node.bounds.left = rect.left - m_margin;
+    node.bounds.top = rect.top - m_margin;
+    node.bounds.right = rect.left + rect.width + m_margin;
+    node.bounds.bottom = rect.top + rect.height + m_margin;
+    node.userData = userData;
+    node.height = 0;
+
+    insertLeaf(proxyID);
+    m_proxyCount++;
+
+    return proxyID;
+}
+
+void DynamicTree::removeProxy(std::int32_t proxyID)
+{
+    XY_ASSERT(proxyID > NullNode && proxyID < static_cast<std::int32_t>(m_nodes.size()), "Invalid proxy ID");
+    XY_ASSERT(m_nodes[proxyID].isLeaf(), "Not a proxy");
+
+    removeLeaf(proxyID);
+    freeNode(proxyID);
+    m_proxyCount--;
+}
+
+bool DynamicTree::moveProxy(std::int32_t proxyID, sf::FloatRect rect, sf::Vector2f displacement)
+{
+    XY_ASSERT(proxyID > NullNode && proxyID < static_cast<std::int32_t>(m_nodes.size()), "Invalid proxy ID");
+    XY_ASSERT(m_nodes[proxyID].isLeaf(), "Not a proxy");
+
+    Bounds bounds;
+    bounds.left = rect.left;
+    bounds.top = rect.top;
+    bounds.right = rect.left + rect.width;
+    bounds.bottom = rect.top + rect.height;
+
+    if (contains(m_nodes[proxyID].bounds, bounds))
+    {
+        return false;
+    }
+
+    removeLeaf(proxyID);
+
+    bounds.left -= m_margin;
+    bounds.top -= m_margin;
+    bounds.right += m_margin;
+    bounds.bottom += m_margin;
+
+    //predict where the proxy is moving to
+    displacement *= DisplacementMultiplier;
+    if (displacement.x < 0.f)
+    {
+        bounds.left += displacement.x;
+    }
+    else
+    {
+        bounds.right += displacement.x;
+    }
+
+    if (displacement.y < 0.f)
+    {
+        bounds.top += displacement.y;
+    }
+    else
+    {
+        bounds.bottom += displacement.y;
+    }
+    m_nodes[proxyID].bounds = bounds;
+
+    insertLeaf(proxyID);
+    return true;
+}
+
+sf::FloatRect DynamicTree::getFatBounds(std::int32_t proxyID) const
+{
+    XY_ASSERT(proxyID > NullNode && proxyID < static_cast<std::int32_t>(m_nodes.size()), "Invalid proxy ID");
+    const auto& bounds = m_nodes[proxyID].bounds;
+    return { bounds.left, bounds.top, bounds.right - bounds.left, bounds.bottom - bounds.top };
+}
+
+std::uint32_t DynamicTree::getUserData(std::int32_t proxyID) const
+{
+    XY_ASSERT(proxyID > NullNode && proxyID < static_cast<std::int32_t>(m_nodes.size()), "Invalid proxy ID");
+    return m_nodes[proxyID].userData;
+}
+
+void DynamicTree::query(sf::FloatRect rect, std::vector<std::uint32_t>& results) const
+{
+    if (m_root == NullNode)
+    {
+        return;
+    }
+
+    Bounds area;
+    area.left = rect.left;
+    area.top = rect.top;
+    area.right = rect.left + rect.width;
+    area.bottom = rect.top + rect.height;
+
+    std::vector<std::int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+
+    while (!stack.empty())
+    {
+        const auto& node = m_nodes[stack.back()];
+        stack.pop_back();
+
+        if (overlaps(node.bounds, area))
+        {
+            if (node.isLeaf())
+            {
+                results.push_back(node.userData);
+            }
+            else
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+}
+
+void DynamicTree::clear()
+{
+    m_nodes.clear();
+    m_root = NullNode;
+    m_freeList = NullNode;
+    m_proxyCount = 0;
+}
+
+std::int32_t DynamicTree::getHeight() const
+{
+    return m_root == NullNode ? 0 : m_nodes[m_root].height;
+}
+
+//private
+std::int32_t DynamicTree::allocateNode()
+{
+    if (m_freeList == NullNode)
+    {
+        m_nodes.emplace_back();
+        return static_cast<std::int32_t>(m_nodes.size() - 1);
+    }
+
+    auto nodeID = m_freeList;
+    m_freeList = m_nodes[nodeID].parent;
+    m_nodes[nodeID] = {};
+    return nodeID;
+}
+
+void DynamicTree::freeNode(std::int32_t nodeID)
+{
+    m_nodes[nodeID].parent = m_freeList;
+    m_nodes[nodeID].height = -1;
+    m_freeList = nodeID;
+}
+
+void DynamicTree::insertLeaf(std::int32_t leaf)
+{
+    if (m_root == NullNode)
+    {
+        m_root = leaf;
+        m_nodes[leaf].parent = NullNode;
+        return;
+    }
+
+    //find the best sibling by walking down the tree and choosing
+    //the child which causes the smallest increase in perimeter
+    const auto leafBounds = m_nodes[leaf].bounds;
+    auto index = m_root;
+    while (!m_nodes[index].isLeaf())
+    {
+        const auto child1 = m_nodes[index].child1;
+        const auto child2 = m_nodes[index].child2;
+
+        const float area = perimeter(m_nodes[index].bounds);
+        const float combinedArea = perimeter(combine(m_nodes[index].bounds, leafBounds));
+
+        //cost of creating a new parent for this node and the new leaf
+        const float cost = 2.f * combinedArea;
+
+        //minimum cost of pushing the leaf further down the tree
+        const float inheritanceCost = 2.f * (combinedArea - area);
+
+        auto descentCost = [&](std::int32_t child)
+        {
+            const float newArea = perimeter(combine(leafBounds, m_nodes[child].bounds));
+            if (m_nodes[child].isLeaf())
+            {
+                return newArea + inheritanceCost;
+            }
+            return (newArea - perimeter(m_nodes[child].bounds)) + inheritanceCost;
+        };
+
+        const float cost1 = descentCost(child1);
+        const float cost2 = descentCost(child2);
+
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+
+        index = (cost1 < cost2) ? child1 : child2;
+    }
+
+    const auto sibling = index;
+
+    //create a new parent for the sibling and the leaf
+    const auto oldParent = m_nodes[sibling].parent;
+    const auto newParent = allocateNode();
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].bounds = combine(leafBounds, m_nodes[sibling].bounds);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].child1 = sibling;
+    m_nodes[newParent].child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != NullNode)
+    {
+        if (m_nodes[oldParent].child1 == sibling)
+        {
+            m_nodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+            m_nodes[oldParent].child2 = newParent;
+        }
+    }
+    else
+    {
+        m_root = newParent;
+    }
+
+    //walk back up the tree fixing heights and bounds
+    index = m_nodes[leaf].parent;
+    while (index != NullNode)
+    {
+        index = balance(index);
+
+        const auto child1 = m_nodes[index].child1;
+        const auto child2 = m_nodes[index].child2;
+
+        m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+        m_nodes[index].bounds = combine(m_nodes[child1].bounds, m_nodes[child2].bounds);
+
+        index = m_nodes[index].parent;
+    }
+}
+
+void DynamicTree::removeLeaf(std::int32_t leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = NullNode;
+        return;
+    }
+
+    const auto parent = m_nodes[leaf].parent;
+    const auto grandParent = m_nodes[parent].parent;
+    const auto sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent != NullNode)
+    {
+        //replace the parent with the sibling
+        if (m_nodes[grandParent].child1 == parent)
+        {
+            m_nodes[grandParent].child1 = sibling;
+        }
+        else
+        {
+            m_nodes[grandParent].child2 = sibling;
+        }
+        m_nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        auto index = grandParent;
+        while (index != NullNode)
+        {
+            index = balance(index);
+
+            const auto child1 = m_nodes[index].child1;
+            const auto child2 = m_nodes[index].child2;
+
+            m_nodes[index].bounds = combine(m_nodes[child1].bounds, m_nodes[child2].bounds);
+            m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+
+            index = m_nodes[index].parent;
+        }
+    }
+    else
+    {
+        m_root = sibling;
+        m_nodes[sibling].parent = NullNode;
+        freeNode(parent);
+    }
+}
+
+std::int32_t DynamicTree::balance(std::int32_t indexA)
+{
+    //performs a left or right rotation if node A is imbalanced
+    auto& a = m_nodes[indexA];
+    if (a.isLeaf() || a.height < 2)
+    {
+        return indexA;
+    }
+
+    const auto indexB = a.child1;
+    const auto indexC = a.child2;
+
+    const auto balanceFactor = m_nodes[indexC].height - m_nodes[indexB].height;
+
+    //rotates the taller child up, where 'up' is the taller child and 'other' its sibling
+    auto rotate = [&](std::int32_t up, std::int32_t other)
+    {
+        auto& nodeA = m_nodes[indexA];
+        auto& nodeUp = m_nodes[up];
+
+        const auto indexF = nodeUp.child1;
+        const auto indexG = nodeUp.child2;
+
+        //swap A and the rising child
+        nodeUp.child1 = indexA;
+        nodeUp.parent = nodeA.parent;
+        nodeA.parent = up;
+
+        //A's old parent should point to the rising child
+        if (nodeUp.parent != NullNode)
+        {
+            if (m_nodes[nodeUp.parent].child1 == indexA)
+            {
+                m_nodes[nodeUp.parent].child1 = up;
+            }
+            else
+            {
+                XY_ASSERT(m_nodes[nodeUp.parent].child2 == indexA, "Corrupt tree");
+                m_nodes[nodeUp.parent].child2 = up;
+            }
+        }
+        else
+        {
+            m_root = up;
+        }
+
+        //the taller grandchild stays with the rising node, the shorter moves to A
+        const bool fTaller = m_nodes[indexF].height > m_nodes[indexG].height;
+        const auto keep = fTaller ? indexF : indexG;
+        const auto give = fTaller ? indexG : indexF;
+
+        nodeUp.child2 = keep;
+        if (nodeA.child1 == up)
+        {
+            nodeA.child1 = give;
+        }
+        else
+        {
+            nodeA.child2 = give;
+        }
+        m_nodes[give].parent = indexA;
+
+        nodeA.bounds = combine(m_nodes[other].bounds, m_nodes[give].bounds);
+        nodeUp.bounds = combine(nodeA.bounds, m_nodes[keep].bounds);
+
+        nodeA.height = 1 + std::max(m_nodes[other].height, m_nodes[give].height);
+        nodeUp.height = 1 + std::max(nodeA.height, m_nodes[keep].height);
+    };
+
+    if (balanceFactor > 1)
+    {
+        rotate(indexC, indexB);
+        return indexC;
+    }
+
+    if (balanceFactor < -1)
+    {
+        rotate(indexB, indexC);
+        return indexB;
+    }
+
+    return indexA;
+}